@@ -0,0 +1,37 @@
+#include <new>
+#include <atomic>
+#include <cstdlib>
+
+#include "allocation_counter.hpp"
+
+// replaces the global allocation functions in a translation unit of
+// its own, i.e., compilers cannot inline them into their callers
+
+namespace {
+
+std::atomic<size_t> s_allocations{0};
+
+} // namespace <anonymous>
+
+size_t allocation_count() {
+    return s_allocations.load();
+}
+
+void* operator new(size_t size) {
+    ++s_allocations;
+    auto result = malloc(size > 0 ? size : 1);
+    if (result == nullptr) throw std::bad_alloc();
+    return result;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    free(ptr);
+}
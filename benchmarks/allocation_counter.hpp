@@ -0,0 +1,10 @@
+#ifndef ALLOCATION_COUNTER_HPP
+#define ALLOCATION_COUNTER_HPP
+
+#include <cstddef>
+
+// returns the number of heap allocations of this process so far,
+// including allocations of libcppa
+size_t allocation_count();
+
+#endif // ALLOCATION_COUNTER_HPP
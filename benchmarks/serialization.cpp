@@ -0,0 +1,236 @@
+// Measures throughput of binary_serializer and binary_deserializer for
+// representative message shapes in both wire formats. Prints one JSON
+// object per shape, format and operation to stdout, e.g.:
+//
+//   {"shape": "strings", "format": "compact", "op": "serialize",
+//    "iterations": 131072, "ns_per_op": 237.85, "bytes_per_op": 276.00,
+//    "allocs_per_op": 2.00}
+//
+// Options:
+//   --min-time=<ms>  run each measurement for at least <ms> milliseconds
+//   --corpus=<dir>   write the serialized shapes to <dir> as seed corpus
+//                    for fuzzing binary_deserializer; shapes containing
+//                    actor addresses are skipped, because their bytes
+//                    differ between runs
+
+#include <map>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <functional>
+
+#include "cppa/cppa.hpp"
+#include "cppa/actor_namespace.hpp"
+#include "cppa/type_lookup_table.hpp"
+#include "cppa/binary_serializer.hpp"
+#include "cppa/binary_deserializer.hpp"
+
+#include "cppa/util/buffer.hpp"
+#include "cppa/util/byte_slice.hpp"
+
+#include "allocation_counter.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+typedef chrono::steady_clock clock_type;
+
+struct small_pod {
+    int32_t a;
+    int16_t b;
+    uint16_t c;
+    double d;
+};
+
+bool operator==(const small_pod& lhs, const small_pod& rhs) {
+    return    lhs.a == rhs.a && lhs.b == rhs.b
+           && lhs.c == rhs.c && lhs.d == rhs.d;
+}
+
+struct person {
+    string name;
+    uint32_t age;
+    vector<string> tags;
+};
+
+bool operator==(const person& lhs, const person& rhs) {
+    return    lhs.name == rhs.name && lhs.age == rhs.age
+           && lhs.tags == rhs.tags;
+}
+
+typedef vector<int32_t> int_vector;
+
+typedef map<string, int_vector> int_vector_map;
+
+struct shape {
+    string name;
+    any_tuple msg;
+    // false if the serialized bytes differ between runs
+    bool stable;
+};
+
+struct result {
+    size_t iterations;
+    double ns_per_op;
+    double bytes_per_op;
+    double allocs_per_op;
+};
+
+// runs f in batches of doubling size until min_time passed
+result measure(const function<size_t ()>& f, chrono::milliseconds min_time) {
+    size_t batch = 1;
+    for (;;) {
+        size_t bytes = 0;
+        auto allocs_before = allocation_count();
+        auto t0 = clock_type::now();
+        for (size_t i = 0; i < batch; ++i) bytes += f();
+        auto t1 = clock_type::now();
+        auto allocs = allocation_count() - allocs_before;
+        auto elapsed = chrono::duration_cast<chrono::nanoseconds>(t1 - t0);
+        if (elapsed >= min_time || batch >= (size_t{1} << 30)) {
+            auto n = static_cast<double>(batch);
+            return {batch,
+                    static_cast<double>(elapsed.count()) / n,
+                    static_cast<double>(bytes) / n,
+                    static_cast<double>(allocs) / n};
+        }
+        batch *= 2;
+    }
+}
+
+void print(const string& shape_name, const char* format, const char* op,
+           const result& res) {
+    cout << "{\"shape\": \"" << shape_name << "\""
+         << ", \"format\": \"" << format << "\""
+         << ", \"op\": \"" << op << "\""
+         << ", \"iterations\": " << res.iterations
+         << ", \"ns_per_op\": " << res.ns_per_op
+         << ", \"bytes_per_op\": " << res.bytes_per_op
+         << ", \"allocs_per_op\": " << res.allocs_per_op
+         << "}" << endl;
+}
+
+vector<shape> make_shapes(const actor& self) {
+    small_pod pod{42, -7, 7, 4.2};
+    person alice{"alice", 42, {"admin", "remote", "libcppa"}};
+    int_vector ints(64);
+    for (size_t i = 0; i < ints.size(); ++i) {
+        ints[i] = static_cast<int32_t>(i * i);
+    }
+    int_vector_map nested;
+    for (int i = 0; i < 8; ++i) {
+        nested.emplace("key" + to_string(i), int_vector(8, i));
+    }
+    return {
+        {"atoms", make_any_tuple(atom("get"), atom("put"), atom("done")),
+         true},
+        {"small_pods", make_any_tuple(int32_t{1}, uint64_t{2}, 3.0), true},
+        {"strings", make_any_tuple(string(16, 'a'), string(256, 'b')), true},
+        {"nested_containers", make_any_tuple(ints, nested), true},
+        {"announced_structs", make_any_tuple(pod, alice), true},
+        {"actor_addresses", make_any_tuple(self, self.address()), false},
+        {"blob_64k",
+         make_any_tuple(util::byte_slice(string(64 * 1024, 'x'))), true},
+        {"blob_1m",
+         make_any_tuple(util::byte_slice(string(1024 * 1024, 'x'))), true}
+    };
+}
+
+bool write_corpus(const string& dir, const shape& s, const char* format,
+                  bool compact, actor_namespace& ns) {
+    // no type lookup table, i.e., each file describes its own types
+    util::buffer buf;
+    binary_serializer bs(&buf, &ns);
+    bs.compact(compact);
+    bs << s.msg;
+    auto path = dir + "/" + s.name + "_" + format + ".bin";
+    ofstream out(path, ios::out | ios::binary);
+    out.write(static_cast<const char*>(buf.data()),
+              static_cast<streamsize>(buf.size()));
+    if (!out) {
+        cerr << "cannot write " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+void run(const shape& s, const char* format, bool compact,
+         chrono::milliseconds min_time, actor_namespace& ns,
+         type_lookup_table& types) {
+    // register the message type once, like peers do after the first
+    // message of a type, to measure the steady state of a connection
+    auto uti = uniform_type_info::from(*s.msg.tuple_type_names());
+    if (types.id_of(uti) == 0) types.emplace(types.max_id() + 1, uti);
+    util::buffer buf;
+    auto res = measure([&]() -> size_t {
+        buf.clear();
+        binary_serializer bs(&buf, &ns, &types);
+        bs.compact(compact);
+        bs << s.msg;
+        return buf.size();
+    }, min_time);
+    print(s.name, format, "serialize", res);
+    auto meta = uniform_typeid<any_tuple>();
+    res = measure([&]() -> size_t {
+        binary_deserializer bd(buf.data(), buf.size(), &ns, &types);
+        bd.compact(compact);
+        any_tuple msg;
+        meta->deserialize(&msg, &bd);
+        return buf.size();
+    }, min_time);
+    print(s.name, format, "deserialize", res);
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    chrono::milliseconds min_time{200};
+    string corpus_dir;
+    for (int i = 1; i < argc; ++i) {
+        if (strncmp(argv[i], "--min-time=", 11) == 0) {
+            min_time = chrono::milliseconds{atoi(argv[i] + 11)};
+        }
+        else if (strncmp(argv[i], "--corpus=", 9) == 0) {
+            corpus_dir = argv[i] + 9;
+        }
+        else {
+            cerr << "usage: " << argv[0]
+                 << " [--min-time=<ms>] [--corpus=<dir>]" << endl;
+            return 1;
+        }
+    }
+    announce<small_pod>(&small_pod::a, &small_pod::b,
+                        &small_pod::c, &small_pod::d);
+    announce<person>(&person::name, &person::age, &person::tags);
+    announce<int_vector>();
+    announce<int_vector_map>();
+    cout << fixed << setprecision(2);
+    bool ok = true;
+    {
+        scoped_actor self;
+        actor_namespace ns;
+        type_lookup_table types;
+        for (auto& s : make_shapes(self)) {
+            for (auto compact : {false, true}) {
+                auto format = compact ? "compact" : "default";
+                if (!corpus_dir.empty()) {
+                    if (s.stable) {
+                        ok = write_corpus(corpus_dir, s, format,
+                                          compact, ns) && ok;
+                    }
+                }
+                else run(s, format, compact, min_time, ns, types);
+            }
+        }
+    }
+    await_all_actors_done();
+    shutdown();
+    return ok ? 0 : 1;
+}
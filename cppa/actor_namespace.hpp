@@ -52,10 +52,23 @@ class actor_namespace {
 
     inline void set_new_element_callback(new_element_callback fun);
 
+    /**
+     * @brief Writes @p ptr to @p sink. Uses short aliases if @p sink
+     *        has an {@link address_lookup_table} for outgoing addresses.
+     */
     void write(serializer* sink, const actor_addr& ptr);
 
+    /**
+     * @brief Reads an address written by {@link write}.
+     */
     actor_addr read(deserializer* source);
 
+    /**
+     * @brief Returns the address of the actor @p aid running on @p node,
+     *        i.e., either a local actor or a (new) proxy.
+     */
+    actor_addr resolve(const node_id_ptr& node, actor_id aid);
+
     /**
      * @brief A map that stores weak actor proxy pointers by actor ids.
      */
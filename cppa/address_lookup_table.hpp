@@ -0,0 +1,159 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_ADDRESS_LOOKUP_TABLE_HPP
+#define CPPA_ADDRESS_LOOKUP_TABLE_HPP
+
+#include <map>
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+#include "cppa/node_id.hpp"
+#include "cppa/abstract_actor.hpp"
+
+namespace cppa {
+
+/**
+ * @brief Maps node IDs and actor addresses to short integer aliases
+ *        for a single connection, i.e., the addresses sent or received
+ *        via one {@link io::peer}.
+ *
+ * The sending side assigns aliases in ascending order, starting at 1,
+ * and transmits the full address along with a new alias only once.
+ * The receiving side learns aliases in the same order. Each table holds
+ * at most {@link max_aliases} nodes and actors. Once a table is full,
+ * the sending side discards all of its aliases and starts again at 1.
+ * The receiving side discards its table as well when receiving a new
+ * definition of the alias 1.
+ */
+class address_lookup_table {
+
+ public:
+
+    static constexpr std::uint32_t max_aliases = 4096;
+
+    address_lookup_table();
+
+    /**
+     * @brief Identifies the aliases assigned by the sending side
+     *        at some point, see {@link truncate}.
+     */
+    struct checkpoint {
+        std::uint32_t generation;
+        std::uint32_t nodes;
+        std::uint32_t actors;
+    };
+
+    /**
+     * @brief Returns the alias for @p node. Assigns a new alias and sets
+     *        @p is_new if @p node is unknown.
+     */
+    std::uint32_t node_alias(const node_id& node, bool& is_new);
+
+    /**
+     * @brief Returns the alias for the actor @p aid running on @p node.
+     *        Assigns a new alias and sets @p is_new if the actor is unknown.
+     */
+    std::uint32_t actor_alias(const node_id& node, actor_id aid, bool& is_new);
+
+    /**
+     * @brief Stores @p node under the next unused node alias @p alias
+     *        or under 1 after discarding all nodes.
+     * @throws std::runtime_error if @p alias is neither the next unused
+     *                            alias nor 1
+     */
+    void emplace_node(std::uint32_t alias, node_id_ptr node);
+
+    /**
+     * @brief Stores @p aid on @p node under the next unused actor alias
+     *        or under 1 after discarding all actors.
+     * @throws std::runtime_error if @p alias is neither the next unused
+     *                            alias nor 1
+     */
+    void emplace_actor(std::uint32_t alias, node_id_ptr node, actor_id aid);
+
+    /**
+     * @brief Returns the node stored as @p alias or @p nullptr.
+     */
+    node_id_ptr node_by_alias(std::uint32_t alias) const;
+
+    /**
+     * @brief Returns the node and actor ID stored as @p alias or
+     *        @p {nullptr, 0}.
+     */
+    std::pair<node_id_ptr, actor_id> actor_by_alias(std::uint32_t alias) const;
+
+    /**
+     * @brief Returns the current state of the aliases assigned
+     *        by the sending side.
+     */
+    inline checkpoint make_checkpoint() const;
+
+    /**
+     * @brief Returns a number that changes whenever aliases assigned
+     *        by the sending side are discarded, i.e., whenever data
+     *        referring to previously assigned aliases becomes invalid.
+     */
+    inline std::uint32_t generation() const;
+
+    /**
+     * @brief Removes all aliases assigned by the sending side after
+     *        @p cp, i.e., undoes aliases assigned for a message that
+     *        could not be sent. Discards all aliases if a table has been
+     *        discarded since @p cp, because the receiving side still uses
+     *        the old aliases and starts again with the next alias 1.
+     */
+    void truncate(const checkpoint& cp);
+
+ private:
+
+    typedef std::pair<std::uint32_t, node_id::host_id_type> node_key;
+
+    typedef std::pair<node_key, actor_id> actor_key;
+
+    void reset_sending_side(bool nodes, bool actors);
+
+    // incremented whenever aliases of the sending side are discarded
+    std::uint32_t m_generation;
+
+    // aliases assigned by the sending side
+    std::map<node_key, std::uint32_t> m_node_aliases;
+    std::map<actor_key, std::uint32_t> m_actor_aliases;
+
+    // aliases learned by the receiving side, stored at index alias - 1
+    std::vector<node_id_ptr> m_nodes;
+    std::vector<std::pair<node_id_ptr, actor_id>> m_actors;
+
+};
+
+inline address_lookup_table::checkpoint
+address_lookup_table::make_checkpoint() const {
+    return {m_generation,
+            static_cast<std::uint32_t>(m_node_aliases.size()),
+            static_cast<std::uint32_t>(m_actor_aliases.size())};
+}
+
+inline std::uint32_t address_lookup_table::generation() const {
+    return m_generation;
+}
+
+} // namespace cppa
+
+#endif // CPPA_ADDRESS_LOOKUP_TABLE_HPP
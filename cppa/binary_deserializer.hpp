@@ -22,6 +22,8 @@
 
 #include "cppa/deserializer.hpp"
 
+#include "cppa/util/byte_slice.hpp"
+
 namespace cppa {
 
 /**
@@ -36,11 +38,13 @@ class binary_deserializer : public deserializer {
 
     binary_deserializer(const void* buf, size_t buf_size,
                         actor_namespace* ns = nullptr,
-                        type_lookup_table* table = nullptr);
+                        type_lookup_table* table = nullptr,
+                        address_lookup_table* addresses = nullptr);
 
     binary_deserializer(const void* begin, const void* m_end,
                         actor_namespace* ns = nullptr,
-                        type_lookup_table* table = nullptr);
+                        type_lookup_table* table = nullptr,
+                        address_lookup_table* addresses = nullptr);
 
     const uniform_type_info* begin_object() override;
     void end_object() override;
@@ -49,11 +53,47 @@ class binary_deserializer : public deserializer {
     primitive_variant read_value(primitive_type ptype) override;
     void read_tuple(size_t, const primitive_type*, primitive_variant*) override;
     void read_raw(size_t num_bytes, void* storage) override;
+    void read_values(primitive_type ptype, size_t num, void* storage) override;
+    bool native_layout() const override;
+    util::byte_slice read_slice(size_t num_bytes) override;
+
+    /**
+     * @brief Returns whether this deserializer expects the compact format.
+     */
+    inline bool compact() const {
+        return m_compact;
+    }
+
+    /**
+     * @brief Enables or disables the compact format.
+     * @see binary_serializer::compact(bool)
+     */
+    inline void compact(bool value) {
+        m_compact = value;
+    }
+
+    /**
+     * @brief Returns the shared buffer holding the data source (if any).
+     */
+    inline const util::shared_buffer_ptr& storage() const {
+        return m_storage;
+    }
+
+    /**
+     * @brief Sets the shared buffer holding the data source, which
+     *        allows {@link read_slice()} to return views instead of copies.
+     * @pre The range passed to the constructor is part of @p ptr.
+     */
+    inline void storage(util::shared_buffer_ptr ptr) {
+        m_storage = std::move(ptr);
+    }
 
  private:
 
     const void* m_pos;
     const void* m_end;
+    bool m_compact;
+    util::shared_buffer_ptr m_storage;
 
 };
 
@@ -45,7 +45,8 @@ class binary_serializer : public serializer {
      */
     binary_serializer(util::buffer* write_buffer,
                       actor_namespace* ns = nullptr,
-                      type_lookup_table* lookup_table = nullptr);
+                      type_lookup_table* lookup_table = nullptr,
+                      address_lookup_table* addresses = nullptr);
 
     void begin_object(const uniform_type_info*) override;
 
@@ -61,9 +62,33 @@ class binary_serializer : public serializer {
 
     void write_raw(size_t num_bytes, const void* data) override;
 
+    void write_values(primitive_type ptype, size_t num,
+                      const void* values) override;
+
+    bool native_layout() const override;
+
+    /**
+     * @brief Returns whether this serializer uses the compact format.
+     */
+    inline bool compact() const {
+        return m_compact;
+    }
+
+    /**
+     * @brief Enables or disables the compact format, which encodes
+     *        integers, lengths and type IDs as variable-length integers
+     *        (LEB128, signed integers in zigzag encoding).
+     * @note The data must be read by a {@link binary_deserializer}
+     *       using the same format.
+     */
+    inline void compact(bool value) {
+        m_compact = value;
+    }
+
  private:
 
     util::buffer* m_sink;
+    bool m_compact;
 
 };
 
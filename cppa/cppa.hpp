@@ -465,6 +465,77 @@ void max_msg_size(size_t size);
  */
 size_t max_msg_size();
 
+/**
+ * @brief Enables or disables the compact wire format for connections to
+ *        other nodes. The compact format encodes integers, lengths and
+ *        type IDs as variable-length integers. It is used only if both
+ *        nodes enabled it and affects only connections established
+ *        afterwards. Disabled by default.
+ */
+void compact_wire_format(bool enable);
+
+/**
+ * @brief Queries whether the compact wire format is enabled.
+ */
+bool compact_wire_format();
+
+/**
+ * @brief Enables or disables shared memory connections to other processes
+ *        on the same host. If enabled, {@link remote_actor} replaces a
+ *        connection to such a process by an {@link io::shm_io_stream}
+ *        as soon as the handshake revealed the host of the remote actor.
+ *        Affects only connections established afterwards and has no
+ *        effect on platforms other than Linux. Enabled by default.
+ */
+void shm_transport(bool enable);
+
+/**
+ * @brief Queries whether shared memory connections are enabled.
+ */
+bool shm_transport();
+
+/**
+ * @brief Sets the minimum size of messages sent compressed to other nodes.
+ *        Messages are compressed only if the receiving node supports it
+ *        and if compressing saves a reasonable amount of bytes. Each
+ *        middleman thread spends at most a fifth of its time compressing
+ *        and sends messages uncompressed otherwise.
+ * @param num_bytes The minimum size of a compressed message or 0 to
+ *                  disable compression, which is the default.
+ */
+void frame_compression_threshold(size_t num_bytes);
+
+/**
+ * @brief Queries the minimum size of messages sent compressed to other
+ *        nodes or 0 if compression is disabled.
+ */
+size_t frame_compression_threshold();
+
+/**
+ * @brief Sets the watermarks for data buffered per remote node. Once more
+ *        than @p high bytes are buffered for a node, messages sent by local
+ *        actors to this node are dropped and the senders receive a
+ *        {@link peer_congested_msg} until less than @p low bytes are
+ *        buffered again. Messages that are not serialized yet, e.g.,
+ *        because no connection to the node exists, count as
+ *        {@link io::default_message_queue::estimated_message_size}
+ *        bytes each.
+ * @param low The number of bytes that ends congestion.
+ * @param high The number of bytes that starts congestion.
+ * @throws std::invalid_argument if <tt>low > high</tt>
+ */
+void peer_buffer_watermarks(size_t low, size_t high);
+
+/**
+ * @brief Queries the low watermark for data buffered per remote node.
+ */
+size_t peer_buffer_low_watermark();
+
+/**
+ * @brief Queries the high watermark for data buffered per remote node.
+ */
+size_t peer_buffer_high_watermark();
+
 // implemented in local_actor.cpp
 /**
  * @brief Anonymously sends @p whom an exit message.
@@ -493,9 +564,17 @@ namespace detail {
 
 void publish_impl(abstract_actor_ptr whom, std::unique_ptr<io::acceptor> aptr);
 
+// publishes @p whom at @p port and remembers the port, so that
+// remote_actor() can skip the network for actors of this process
+void publish_impl(abstract_actor_ptr whom, std::uint16_t port,
+                  const char* addr);
+
 abstract_actor_ptr remote_actor_impl(io::stream_ptr_pair io,
                                      std::set<std::string> expected_interface);
 
+abstract_actor_ptr remote_actor_impl(const char* host, std::uint16_t port,
+                                     std::set<std::string> expected_interface);
+
 template<class List>
 struct typed_remote_actor_helper;
 
@@ -511,8 +590,11 @@ struct typed_remote_actor_helper<util::type_list<Ts...>> {
         return res;
     }
     return_type operator()(const char* host, std::uint16_t port) {
-        auto ptr = io::tcp_io_stream::connect_to(host, port);
-        return (*this)(io::stream_ptr_pair(ptr, ptr));
+        auto iface = return_type::get_interface();
+        auto tmp = remote_actor_impl(host, port, std::move(iface));
+        return_type res;
+        raw_access::unsafe_assign(res, tmp);
+        return res;
     }
 };
 
@@ -540,6 +622,20 @@ void publish(actor whom, std::uint16_t port, const char* addr = nullptr);
  */
 void publish(actor whom, std::unique_ptr<io::acceptor> acceptor);
 
+#ifndef CPPA_WINDOWS
+// implemented in unicast_network.cpp
+/**
+ * @brief Publishes @p whom at the Unix domain socket @p path, i.e.,
+ *        for processes on the same host.
+ *
+ * The connection is automatically closed if the lifetime of @p whom ends.
+ * @param whom Actor that should be published at @p path.
+ * @param path File system path of the socket.
+ * @throws bind_failure
+ */
+void publish(actor whom, const std::string& path);
+#endif // CPPA_WINDOWS
+
 // implemented in unicast_network.cpp
 /**
  * @brief Establish a new connection to a remote actor via @p connection.
@@ -553,6 +649,9 @@ actor remote_actor(io::stream_ptr_pair connection);
 
 /**
  * @brief Establish a new connection to the actor at @p host on given @p port.
+ *
+ * If @p host refers to the local host and this process has published an
+ * actor at @p port, the actor itself is returned without connecting.
  * @param host Valid hostname or IP address.
  * @param port TCP port.
  * @returns An {@link actor_ptr} to the proxy instance
@@ -568,6 +667,32 @@ inline actor remote_actor(const std::string& host, std::uint16_t port) {
     return remote_actor(host.c_str(), port);
 }
 
+#ifndef CPPA_WINDOWS
+/**
+ * @brief Establish a new connection to the actor published at the
+ *        Unix domain socket @p path.
+ * @param path File system path of the socket.
+ * @returns An {@link actor_ptr} to the proxy instance
+ *          representing a remote actor.
+ * @throws std::invalid_argument Thrown when connecting to a typed actor.
+ */
+actor remote_actor(const std::string& path);
+#endif // CPPA_WINDOWS
+
+/**
+ * @brief Establishes a new connection to the actor at @p host on given
+ *        @p port without waiting for the connection and the handshake.
+ *        Once the handshake is done, @p listener receives either
+ *        <tt>(atom("CONNECTED"), host, port, actor)</tt> or
+ *        <tt>(atom("CONN_FAIL"), host, port, std::string)</tt>, whereas
+ *        the string describes the error.
+ * @note Host names are resolved by a helper thread of the middleman,
+ *       unless the address of @p host is cached.
+ */
+void remote_actor_async(const actor& listener,
+                        std::string host,
+                        std::uint16_t port);
+
 /**
  * @copydoc publish(actor,std::unique_ptr<io::acceptor>)
  */
@@ -584,8 +709,7 @@ template<typename... Rs>
 void typed_publish(typed_actor<Rs...> whom,
                    std::uint16_t port, const char* addr = nullptr) {
     if (!whom) return;
-    detail::publish_impl(detail::raw_access::get(whom),
-                         io::tcp_acceptor::create(port, addr));
+    detail::publish_impl(detail::raw_access::get(whom), port, addr);
 }
 
 /**
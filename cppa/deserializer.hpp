@@ -31,8 +31,9 @@ namespace cppa {
 class object;
 class actor_namespace;
 class type_lookup_table;
+class address_lookup_table;
 
-namespace util { class buffer; }
+namespace util { class buffer; class byte_slice; }
 
 /**
  * @ingroup TypeSystem
@@ -46,7 +47,8 @@ class deserializer {
  public:
 
     deserializer(actor_namespace* ns = nullptr,
-                 type_lookup_table* incoming_types = nullptr);
+                 type_lookup_table* incoming_types = nullptr,
+                 address_lookup_table* incoming_addresses = nullptr);
 
     virtual ~deserializer();
 
@@ -111,6 +113,29 @@ class deserializer {
      */
     virtual void read_raw(size_t num_bytes, void* storage) = 0;
 
+    /**
+     * @brief Reads the elements of a sequence of @p num values of the
+     *        arithmetic type @p ptype into the contiguous @p storage.
+     * @note The default implementation calls {@link read_value()}
+     *       for each element.
+     */
+    virtual void read_values(primitive_type ptype, size_t num, void* storage);
+
+    /**
+     * @brief Returns whether values written as one block by a serializer
+     *        using the native layout can be read using {@link read_raw()}.
+     * @see serializer::native_layout()
+     */
+    virtual bool native_layout() const;
+
+    /**
+     * @brief Reads a raw memory block of @p num_bytes bytes as slice.
+     * @note The default implementation copies the bytes using
+     *       {@link read_raw()}, deserializers reading from a shared
+     *       buffer can return a view to the data source instead.
+     */
+    virtual util::byte_slice read_slice(size_t num_bytes);
+
     inline actor_namespace* get_namespace() {
         return m_namespace;
     }
@@ -119,12 +144,17 @@ class deserializer {
         return m_incoming_types;
     }
 
+    inline address_lookup_table* incoming_addresses() {
+        return m_incoming_addresses;
+    }
+
     void read_raw(size_t num_bytes, util::buffer& storage);
 
  private:
 
     actor_namespace* m_namespace;
     type_lookup_table* m_incoming_types;
+    address_lookup_table* m_incoming_addresses;
 
 };
 
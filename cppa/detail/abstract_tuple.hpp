@@ -115,6 +115,11 @@ constexpr types_only_eq_type types_only_eq;
 
 std::string get_tuple_type_names(const detail::abstract_tuple&);
 
+// returns the same string as get_tuple_type_names() from a global table,
+// i.e., tuples with equal element types share a single string and the
+// address of the string identifies the element types of a tuple
+const std::string* interned_tuple_type_names(const detail::abstract_tuple&);
+
 } // namespace detail
 } // namespace cppa
 
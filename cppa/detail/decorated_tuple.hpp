@@ -20,6 +20,7 @@
 #ifndef CPPA_DETAIL_DECORATED_TUPLE_HPP
 #define CPPA_DETAIL_DECORATED_TUPLE_HPP
 
+#include <atomic>
 #include <vector>
 #include <algorithm>
 
@@ -91,6 +92,9 @@ class decorated_tuple : public abstract_tuple {
     rtti        m_token;
     vector_type m_mapping;
 
+    // computed on first use, see interned_tuple_type_names()
+    mutable std::atomic<const std::string*> m_type_names;
+
     void init();
 
     void init(size_t);
@@ -103,7 +107,7 @@ class decorated_tuple : public abstract_tuple {
 
     decorated_tuple(pointer, rtti, vector_type&&);
 
-    decorated_tuple(const decorated_tuple&) = default;
+    decorated_tuple(const decorated_tuple&);
 
 };
 
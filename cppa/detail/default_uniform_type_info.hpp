@@ -20,7 +20,10 @@
 #ifndef CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 #define CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 
+#include <vector>
 #include <memory>
+#include <cstring>
+#include <algorithm>
 
 #include "cppa/unit.hpp"
 #include "cppa/anything.hpp"
@@ -31,6 +34,7 @@
 #include "cppa/util/type_traits.hpp"
 #include "cppa/util/abstract_uniform_type_info.hpp"
 
+#include "cppa/detail/ieee_754.hpp"
 #include "cppa/detail/raw_access.hpp"
 #include "cppa/detail/types_array.hpp"
 #include "cppa/detail/type_to_ptype.hpp"
@@ -81,12 +85,25 @@ typedef std::integral_constant<int, 0> primitive_impl;
 typedef std::integral_constant<int, 1> list_impl;
 typedef std::integral_constant<int, 2> map_impl;
 typedef std::integral_constant<int, 3> pair_impl;
+typedef std::integral_constant<int, 4> array_impl;
 typedef std::integral_constant<int, 9> recursive_impl;
 
+// vectors of arithmetic types are (de)serialized as contiguous block
+template<typename T>
+struct is_arithmetic_vector : std::false_type { };
+
+template<typename T, typename A>
+struct is_arithmetic_vector<std::vector<T, A>>
+: std::integral_constant<bool,    std::is_arithmetic<T>::value
+                               && !std::is_same<T, bool>::value
+                               && !std::is_same<T, long double>::value> { };
+
 template<typename T>
 constexpr int impl_id() {
     return util::is_primitive<T>::value
            ? 0
+           : is_arithmetic_vector<T>::value
+           ? 4
            : (is_stl_compliant_list<T>::value
               ? 1
               : (is_stl_compliant_map<T>::value
@@ -141,6 +158,15 @@ class default_serialize_policy {
         s->end_sequence();
     }
 
+    template<typename T>
+    void simpl(const T& val, serializer* s, array_impl) const {
+        typedef typename T::value_type value_type;
+        s->begin_sequence(val.size());
+        s->write_values(type_to_ptype<value_type>::ptype, val.size(),
+                        val.data());
+        s->end_sequence();
+    }
+
     template<typename T>
     void simpl(const T& val, serializer* s, map_impl) const {
         // lists and maps share code for serialization
@@ -177,6 +203,25 @@ class default_serialize_policy {
         d->end_sequence();
     }
 
+    template<typename T>
+    void dimpl(T& storage, deserializer* d, array_impl) const {
+        typedef typename T::value_type value_type;
+        // grow in steps to not allocate memory for an arbitrary
+        // size before the data source ran out of data
+        constexpr size_t max_step = 64 * 1024;
+        storage.clear();
+        size_t size = d->begin_sequence();
+        storage.reserve(std::min(size, max_step));
+        for (size_t pos = 0; pos < size; ) {
+            auto num = std::min(size - pos, max_step);
+            storage.resize(pos + num);
+            d->read_values(type_to_ptype<value_type>::ptype, num,
+                           storage.data() + pos);
+            pos += num;
+        }
+        d->end_sequence();
+    }
+
     template<typename T>
     void dimpl(T& storage, deserializer* d, map_impl) const {
         storage.clear();
@@ -434,27 +479,102 @@ unique_uti new_member_tinfo(GRes (C::*getter)() const,
                                 std::move(meminf)));
 }
 
+// members of these types have a fixed size on the wire
+template<typename T>
+struct is_native_member {
+    static constexpr bool value =
+           std::is_enum<T>::value
+        || (   std::is_arithmetic<T>::value
+            && !std::is_same<T, bool>::value
+            && !std::is_same<T, long double>::value);
+};
+
 template<typename T>
 class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
 
+    // members of announced types consisting only of native members are
+    // (de)serialized as one block if the serializer uses the native
+    // layout; offsets are known only at runtime, because member pointers
+    // are passed as function arguments to announce()
+    struct native_member {
+        size_t offset;
+        size_t size;
+        primitive_type ptype; // pt_float and pt_double need packing
+    };
+
+    static constexpr size_t max_native_size = 256;
+
  public:
 
     template<typename... Ts>
-    default_uniform_type_info(Ts&&... args) {
+    default_uniform_type_info(Ts&&... args)
+    : m_native(true), m_native_size(0), m_single_block(false) {
         push_back(std::forward<Ts>(args)...);
+        init_native_layout();
     }
 
-    default_uniform_type_info() {
+    default_uniform_type_info()
+    : m_native(false), m_native_size(0), m_single_block(false) {
         typedef member_tinfo<T, fake_access_policy<T> > result_type;
         m_members.push_back(unique_uti(new result_type));
     }
 
     void serialize(const void* obj, serializer* s) const override {
+        if (m_native && s->native_layout()) {
+            if (m_single_block) {
+                s->write_raw(sizeof(T), obj);
+                return;
+            }
+            char buf[max_native_size];
+            auto src = reinterpret_cast<const char*>(obj);
+            size_t pos = 0;
+            for (auto& m : m_native_members) {
+                auto mem = src + m.offset;
+                if (m.ptype == pt_float) {
+                    auto tmp = pack754(*reinterpret_cast<const float*>(mem));
+                    memcpy(buf + pos, &tmp, sizeof(tmp));
+                }
+                else if (m.ptype == pt_double) {
+                    auto tmp = pack754(*reinterpret_cast<const double*>(mem));
+                    memcpy(buf + pos, &tmp, sizeof(tmp));
+                }
+                else memcpy(buf + pos, mem, m.size);
+                pos += m.size;
+            }
+            s->write_raw(m_native_size, buf);
+            return;
+        }
         // serialize each member
         for (auto& m : m_members) m->serialize(obj, s);
     }
 
     void deserialize(void* obj, deserializer* d) const override {
+        if (m_native && d->native_layout()) {
+            if (m_single_block) {
+                d->read_raw(sizeof(T), obj);
+                return;
+            }
+            char buf[max_native_size];
+            d->read_raw(m_native_size, buf);
+            auto dst = reinterpret_cast<char*>(obj);
+            size_t pos = 0;
+            for (auto& m : m_native_members) {
+                auto mem = dst + m.offset;
+                if (m.ptype == pt_float) {
+                    std::uint32_t tmp;
+                    memcpy(&tmp, buf + pos, sizeof(tmp));
+                    *reinterpret_cast<float*>(mem) = unpack754(tmp);
+                }
+                else if (m.ptype == pt_double) {
+                    std::uint64_t tmp;
+                    memcpy(&tmp, buf + pos, sizeof(tmp));
+                    *reinterpret_cast<double*>(mem) = unpack754(tmp);
+                }
+                else memcpy(mem, buf + pos, m.size);
+                pos += m.size;
+            }
+            return;
+        }
         // deserialize each member
         for (auto& m : m_members) m->deserialize(obj, d);
     }
@@ -482,12 +602,55 @@ class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
         return false;
     }
 
+    void init_native_layout() {
+        if (m_native_members.empty() || m_native_size > max_native_size) {
+            m_native = false;
+            return;
+        }
+        // a struct without padding and without floating point
+        // members is written as it is stored in memory
+        size_t pos = 0;
+        for (auto& m : m_native_members) {
+            if (m.offset != pos || m.ptype == pt_float || m.ptype == pt_double) {
+                return;
+            }
+            pos += m.size;
+        }
+        m_single_block = pos == sizeof(T);
+    }
+
+    template<typename R, class C>
+    void add_native_member(R C::* memptr,
+                           typename std::enable_if<
+                                  is_native_member<R>::value
+                               && std::is_same<C, T>::value
+                           >::type* = 0) {
+        // computes the offset without constructing an instance of T
+        typename std::aligned_storage<sizeof(C), alignof(C)>::type dummy;
+        auto base = reinterpret_cast<const C*>(&dummy);
+        auto offset =   reinterpret_cast<const char*>(&(base->*memptr))
+                      - reinterpret_cast<const char*>(base);
+        auto ptype = std::is_floating_point<R>::value ? type_to_ptype<R>::ptype
+                                                       : pt_null;
+        m_native_members.push_back(native_member{static_cast<size_t>(offset),
+                                                 sizeof(R), ptype});
+        m_native_size += sizeof(R);
+    }
+
+    // members of base classes or of non-native types
+    // are always serialized separately
+    template<typename M>
+    void add_native_member(M) {
+        m_native = false;
+    }
+
     // terminates recursion
     inline void push_back() { }
 
     template<typename R, class C, typename... Ts>
     void push_back(R C::* memptr, Ts&&... args) {
         m_members.push_back(new_member_tinfo(memptr));
+        add_native_member(memptr);
         push_back(std::forward<Ts>(args)...);
     }
 
@@ -500,6 +663,7 @@ class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
                    >& pr,
                    Ts&&... args) {
         m_members.push_back(new_member_tinfo(pr.first, unique_uti(pr.second)));
+        m_native = false;
         push_back(std::forward<Ts>(args)...);
     }
 
@@ -512,6 +676,7 @@ class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
                    >& pr,
                    Ts&&... args) {
         m_members.push_back(new_member_tinfo(pr.first, pr.second));
+        m_native = false;
         push_back(std::forward<Ts>(args)...);
     }
 
@@ -531,11 +696,17 @@ class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
         m_members.push_back(new_member_tinfo(pr.first.first,
                                              pr.first.second,
                                              unique_uti(pr.second)));
+        m_native = false;
         push_back(std::forward<Ts>(args)...);
     }
 
     std::vector<unique_uti> m_members;
 
+    bool m_native;
+    size_t m_native_size;
+    bool m_single_block;
+    std::vector<native_member> m_native_members;
+
 };
 
 template<typename... Rs>
@@ -0,0 +1,181 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_DETAIL_META_COW_TUPLE_HPP
+#define CPPA_DETAIL_META_COW_TUPLE_HPP
+
+#include <string>
+#include <typeinfo>
+#include <type_traits>
+
+#include "cppa/anything.hpp"
+#include "cppa/cow_tuple.hpp"
+#include "cppa/serializer.hpp"
+#include "cppa/deserializer.hpp"
+#include "cppa/uniform_type_info.hpp"
+
+#include "cppa/util/int_list.hpp"
+#include "cppa/util/algorithm.hpp"
+#include "cppa/util/type_list.hpp"
+#include "cppa/util/type_traits.hpp"
+
+namespace cppa {
+namespace detail {
+
+template<long Pos, typename Tuple, typename T>
+typename std::enable_if<util::is_primitive<T>::value>::type
+serialze_single(serializer* sink, const Tuple&, const T& value) {
+    sink->write_value(value);
+}
+
+template<long Pos, typename Tuple, typename T>
+typename std::enable_if<not util::is_primitive<T>::value>::type
+serialze_single(serializer* sink, const Tuple& tup, const T& value) {
+    tup.type_at(Pos)->serialize(&value, sink);
+}
+
+// end of recursion
+template<typename Tuple>
+void do_serialize(serializer*, const Tuple&, util::int_list<>) { }
+
+// end of recursion
+template<typename Tuple, long I, long... Is>
+void do_serialize(serializer* sink, const Tuple& tup, util::int_list<I, Is...>) {
+    serialze_single<I>(sink, tup, get<I>(tup));
+    do_serialize(sink, tup, util::int_list<Is...>{});
+}
+
+template<long Pos, typename Tuple, typename T>
+typename std::enable_if<util::is_primitive<T>::value>::type
+deserialze_single(deserializer* source, Tuple&, T& value) {
+    value = source->read<T>();
+}
+
+template<long Pos, typename Tuple, typename T>
+typename std::enable_if<not util::is_primitive<T>::value>::type
+deserialze_single(deserializer* source, Tuple& tup, T& value) {
+    tup.type_at(Pos)->deserialize(&value, source);
+}
+
+// end of recursion
+template<typename Tuple>
+void do_deserialize(deserializer*, const Tuple&, util::int_list<>) { }
+
+// end of recursion
+template<typename Tuple, long I, long... Is>
+void do_deserialize(deserializer* source, Tuple& tup, util::int_list<I, Is...>) {
+    deserialze_single<I>(source, tup, get_ref<I>(tup));
+    do_deserialize(source, tup, util::int_list<Is...>{});
+}
+
+template<typename T, typename... Ts>
+class meta_cow_tuple : public uniform_type_info {
+
+ public:
+
+    typedef cow_tuple<T, Ts...> tuple_type;
+
+    meta_cow_tuple() {
+        m_name = "@<>+";
+        m_name += detail::to_uniform_name<T>();
+        util::splice(m_name, "+", detail::to_uniform_name<Ts>()...);
+    }
+
+    const char* name() const override {
+        return m_name.c_str();
+    }
+
+    void serialize(const void* instance, serializer* sink) const override {
+        auto& ref = *cast(instance);
+        do_serialize(sink, ref, util::get_indices(ref));
+    }
+
+    void deserialize(void* instance, deserializer* source) const override {
+        auto& ref = *cast(instance);
+        do_deserialize(source, ref, util::get_indices(ref));
+    }
+
+    void* new_instance(const void* other = nullptr) const override {
+        return (other) ? new tuple_type{*cast(other)} : new tuple_type;
+    }
+
+    void delete_instance(void* instance) const override {
+        delete cast(instance);
+    }
+
+    any_tuple as_any_tuple(void* instance) const override {
+        return (instance) ? any_tuple{*cast(instance)} : any_tuple{};
+    }
+
+    bool equal_to(const std::type_info& tinfo) const override {
+        return typeid(tuple_type) == tinfo;
+    }
+
+    bool equals(const void* instance1, const void* instance2) const override {
+        return *cast(instance1) == *cast(instance2);
+    }
+
+ private:
+
+    inline tuple_type* cast(void* ptr) const {
+        return reinterpret_cast<tuple_type*>(ptr);
+    }
+
+    inline const tuple_type* cast(const void* ptr) const {
+        return reinterpret_cast<const tuple_type*>(ptr);
+    }
+
+    std::string m_name;
+
+};
+
+// adds @p hint to the type system unless it already contains
+// a statically typed tuple of the same name (takes ownership)
+void add_tuple_hint(uniform_type_info* hint);
+
+template<typename T>
+struct is_hintable {
+    static constexpr bool value =    !std::is_same<T, anything>::value
+                                  && !std::is_pointer<T>::value
+                                  && std::is_default_constructible<T>::value
+                                  && std::is_copy_constructible<T>::value
+                                  && util::is_comparable<T, T>::value;
+};
+
+template<class Pattern,
+         bool Enabled =    (util::tl_size<Pattern>::value > 0)
+                        && util::tl_forall<Pattern, is_hintable>::value>
+struct tuple_hint {
+    static inline void add() { }
+};
+
+// registers a meta_cow_tuple once per statically typed pattern, allowing
+// remote messages matching the pattern to use a flat tuple_vals layout
+template<typename... Ts>
+struct tuple_hint<util::type_list<Ts...>, true> {
+    static void add() {
+        static bool added = (add_tuple_hint(new meta_cow_tuple<Ts...>), true);
+        static_cast<void>(added);
+    }
+};
+
+} // namespace detail
+} // namespace cppa
+
+#endif // CPPA_DETAIL_META_COW_TUPLE_HPP
@@ -20,6 +20,7 @@
 #ifndef CPPA_DETAIL_OBJECT_ARRAY_HPP
 #define CPPA_DETAIL_OBJECT_ARRAY_HPP
 
+#include <atomic>
 #include <vector>
 
 #include "cppa/object.hpp"
@@ -37,8 +38,8 @@ class object_array : public abstract_tuple {
     using abstract_tuple::const_iterator;
 
     object_array();
-    object_array(object_array&&) = default;
-    object_array(const object_array&) = default;
+    object_array(object_array&&);
+    object_array(const object_array&);
 
     void push_back(object&& what);
 
@@ -60,6 +61,9 @@ class object_array : public abstract_tuple {
 
     std::vector<object> m_elements;
 
+    // computed on first use, see interned_tuple_type_names()
+    mutable std::atomic<const std::string*> m_type_names;
+
 };
 
 } // namespace detail
@@ -105,8 +105,8 @@ class tuple_vals : public abstract_tuple {
 
     const std::string* tuple_type_names() const override {
         // produced name is equal for all instances
-        static std::string result = get_tuple_type_names(*this);
-        return &result;
+        static auto result = interned_tuple_type_names(*this);
+        return result;
     }
 
  private:
@@ -35,6 +35,7 @@
 #include "cppa/system_messages.hpp"
 
 #include "cppa/util/buffer.hpp"
+#include "cppa/util/byte_slice.hpp"
 #include "cppa/util/duration.hpp"
 #include "cppa/util/type_list.hpp"
 
@@ -68,11 +69,13 @@ using mapped_type_list = util::type_list<
     message_header,
     new_connection_msg,
     new_data_msg,
+    peer_congested_msg,
     sync_exited_msg,
     sync_timeout_msg,
     timeout_msg,
     unit_t,
     util::buffer,
+    util::byte_slice,
     util::duration,
     double,
     float,
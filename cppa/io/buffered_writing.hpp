@@ -20,6 +20,8 @@
 #ifndef CPPA_IO_BUFFERED_WRITING_HPP
 #define CPPA_IO_BUFFERED_WRITING_HPP
 
+#include <deque>
+#include <vector>
 #include <utility>
 
 #include "cppa/util/buffer.hpp"
@@ -36,32 +38,61 @@ class buffered_writing : public Base {
 
     typedef Base super;
 
+    // a new segment is started once the current one exceeds this size
+    static constexpr size_t segment_size = 64 * 1024;
+
+    // maximum number of cleared segments kept for later reuse
+    static constexpr size_t max_pooled_segments = 4;
+
+    // maximum number of segments passed to a single gather write
+    static constexpr size_t max_slices = 16;
+
  public:
 
     template<typename... Ts>
     buffered_writing(middleman* mm, output_stream_ptr out, Ts&&... args)
     : super{std::forward<Ts>(args)...}, m_parent{mm}, m_out{out}
-    , m_has_unwritten_data{false} { }
+    , m_has_unwritten_data{false}, m_offset{0}, m_sealed{0}
+    , m_priority_offset{0} {
+        m_segments.emplace_back();
+    }
 
     continue_writing_result continue_writing() override {
         CPPA_LOG_TRACE("");
         CPPA_LOG_DEBUG_IF(!m_has_unwritten_data, "nothing to write (done)");
         while (m_has_unwritten_data) {
+            io_slice slices[max_slices];
+            size_t num_slices = 0;
+            size_t total = 0;
+            auto add_slice = [&](util::buffer& buf, size_t offset) {
+                if (buf.size() > offset && num_slices < max_slices) {
+                    slices[num_slices].data = buf.offset_data(offset);
+                    slices[num_slices].size = buf.size() - offset;
+                    total += slices[num_slices].size;
+                    ++num_slices;
+                }
+            };
+            // the priority lane overtakes all segments except
+            // a partially written one
+            auto i = m_segments.begin();
+            if (m_offset > 0) add_slice(*i++, m_offset);
+            add_slice(m_priority_lane, m_priority_offset);
+            for (; i != m_segments.end(); ++i) add_slice(*i, 0);
             size_t written;
-            try { written = m_out->write_some(m_buf.data(), m_buf.size()); }
+            try { written = m_out->write_some_vec(slices, num_slices); }
             catch (std::exception& e) {
                 CPPA_LOG_ERROR(to_verbose_string(e));
                 static_cast<void>(e); // keep compiler happy
                 return continue_writing_result::failure;
             }
-            if (written != m_buf.size()) {
-                CPPA_LOG_DEBUG("tried to write " << m_buf.size() << "bytes, "
+            consume(written);
+            if (written != total) {
+                CPPA_LOG_DEBUG("tried to write " << total << "bytes, "
                                << "only " << written << " bytes written");
-                m_buf.erase_leading(written);
                 return continue_writing_result::continue_later;
             }
-            else {
-                m_buf.clear();
+            else if (   m_segments.size() == 1 && m_segments.front().empty()
+                     && m_priority_lane.empty()) {
                 m_has_unwritten_data = false;
                 CPPA_LOG_DEBUG("write done, " << written << " bytes written");
             }
@@ -73,8 +104,24 @@ class buffered_writing : public Base {
         return m_has_unwritten_data;
     }
 
+    /**
+     * @brief Returns the number of bytes not yet written to the data sink.
+     */
+    inline size_t unwritten_bytes() const {
+        return   m_sealed + m_segments.back().size() - m_offset
+               + m_priority_lane.size() - m_priority_offset;
+    }
+
+    /**
+     * @brief Returns the number of bytes a single call to
+     *        {@link continue_writing()} passes to the data sink at most.
+     */
+    static constexpr size_t write_window() {
+        return segment_size * max_slices;
+    }
+
     void write(size_t num_bytes, const void* data) {
-        m_buf.write(num_bytes, data);
+        write_buffer().write(num_bytes, data);
         register_for_writing();
     }
 
@@ -83,11 +130,10 @@ class buffered_writing : public Base {
     }
 
     void write(util::buffer&& buf) {
-        if (m_buf.empty()) m_buf = std::move(buf);
-        else {
-            m_buf.write(buf.size(), buf.data());
-            buf.clear();
-        }
+        auto& wbuf = write_buffer();
+        if (wbuf.empty()) wbuf = std::move(buf);
+        else wbuf.write(buf.size(), buf.data());
+        buf.clear();
         register_for_writing();
     }
 
@@ -99,8 +145,30 @@ class buffered_writing : public Base {
         }
     }
 
-    inline util::buffer& write_buffer() {
-        return m_buf;
+    /**
+     * @brief Returns the segment new data should be appended to. A single
+     *        frame must be written to the returned buffer at once, because
+     *        subsequent calls may return a different segment.
+     */
+    util::buffer& write_buffer() {
+        if (m_segments.back().size() >= segment_size) {
+            m_sealed += m_segments.back().size();
+            if (m_pool.empty()) m_segments.emplace_back();
+            else {
+                m_segments.push_back(std::move(m_pool.back()));
+                m_pool.pop_back();
+            }
+        }
+        return m_segments.back();
+    }
+
+    /**
+     * @brief Returns the buffer for frames that overtake all data in
+     *        {@link write_buffer()} except a partially written segment.
+     *        A single frame must be written to the returned buffer at once.
+     */
+    util::buffer& priority_buffer() {
+        return m_priority_lane;
     }
 
  protected:
@@ -113,10 +181,63 @@ class buffered_writing : public Base {
 
  private:
 
+    // drops @p num_bytes in the order used by continue_writing()
+    void consume(size_t num_bytes) {
+        if (m_offset > 0) num_bytes = consume_segment(num_bytes);
+        num_bytes = consume_priority_lane(num_bytes);
+        while (num_bytes > 0) num_bytes = consume_segment(num_bytes);
+    }
+
+    // drops up to @p num_bytes from the first segment and returns the
+    // remainder; a fully written segment is recycled, a partially
+    // written segment only advances m_offset
+    size_t consume_segment(size_t num_bytes) {
+        auto& front = m_segments.front();
+        auto available = front.size() - m_offset;
+        if (num_bytes < available) {
+            m_offset += num_bytes;
+            return 0;
+        }
+        num_bytes -= available;
+        m_offset = 0;
+        if (m_segments.size() == 1) {
+            front.clear();
+            return num_bytes;
+        }
+        m_sealed -= front.size();
+        front.clear();
+        if (m_pool.size() < max_pooled_segments) {
+            m_pool.push_back(std::move(front));
+        }
+        m_segments.pop_front();
+        return num_bytes;
+    }
+
+    // drops up to @p num_bytes from the priority lane
+    // and returns the remainder
+    size_t consume_priority_lane(size_t num_bytes) {
+        auto available = m_priority_lane.size() - m_priority_offset;
+        if (num_bytes < available) {
+            m_priority_offset += num_bytes;
+            return 0;
+        }
+        m_priority_lane.clear();
+        m_priority_offset = 0;
+        return num_bytes - available;
+    }
+
     middleman* m_parent;
     output_stream_ptr m_out;
     bool m_has_unwritten_data;
-    util::buffer m_buf;
+    // offset of the first unwritten byte in m_segments.front()
+    size_t m_offset;
+    // number of bytes in all segments but the last one
+    size_t m_sealed;
+    std::deque<util::buffer> m_segments;
+    std::vector<util::buffer> m_pool;
+    // frames written before all segments not yet started
+    util::buffer m_priority_lane;
+    size_t m_priority_offset;
 
 };
 
@@ -20,7 +20,7 @@
 #ifndef CPPA_IO_DEFAULT_MESSAGE_QUEUE_HPP
 #define CPPA_IO_DEFAULT_MESSAGE_QUEUE_HPP
 
-#include <vector>
+#include <deque>
 
 #include "cppa/any_tuple.hpp"
 #include "cppa/ref_counted.hpp"
@@ -37,6 +37,12 @@ class default_message_queue : public ref_counted {
 
     typedef value_type& reference;
 
+    /**
+     * @brief The number of bytes a message that is not serialized yet
+     *        accounts for when checking whether a connection is congested.
+     */
+    static constexpr size_t estimated_message_size = 128;
+
     ~default_message_queue();
 
     template<typename... Ts>
@@ -46,15 +52,17 @@ class default_message_queue : public ref_counted {
 
     inline bool empty() const { return m_impl.empty(); }
 
+    inline size_t size() const { return m_impl.size(); }
+
     inline value_type pop() {
         value_type result(std::move(m_impl.front()));
-        m_impl.erase(m_impl.begin());
+        m_impl.pop_front();
         return result;
     }
 
  private:
 
-    std::vector<value_type> m_impl;
+    std::deque<value_type> m_impl;
 
 };
 
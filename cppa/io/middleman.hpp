@@ -21,8 +21,12 @@
 #define CPPA_IO_MIDDLEMAN_HPP
 
 #include <map>
+#include <set>
+#include <string>
 #include <vector>
+#include <chrono>
 #include <memory>
+#include <exception>
 #include <functional>
 
 #include "cppa/node_id.hpp"
@@ -43,6 +47,7 @@ namespace cppa {
 namespace io {
 
 class peer;
+class resolver;
 class continuable;
 class input_stream;
 class peer_acceptor;
@@ -52,6 +57,14 @@ class middleman_event_handler;
 typedef intrusive_ptr<input_stream> input_stream_ptr;
 typedef intrusive_ptr<output_stream> output_stream_ptr;
 
+/**
+ * @brief Receives the result of a handshake started by
+ *        {@link middleman::new_client_peer}, i.e., either the
+ *        remote actor or the error that occurred.
+ */
+typedef std::function<void (abstract_actor_ptr, std::exception_ptr)>
+        handshake_handler;
+
 /**
  * @brief Multiplexes asynchronous IO.
  * @note No member function except for @p run_later is safe to call from
@@ -71,6 +84,15 @@ class middleman {
      */
     virtual void run_later(std::function<void()> fun) = 0;
 
+    /**
+     * @brief Runs @p fun in the event loop of the middleman once
+     *        @p rel_time has passed. Functors that are not yet due
+     *        are discarded when the middleman shuts down.
+     * @warning This member function is not thread-safe.
+     */
+    virtual void run_delayed(std::chrono::milliseconds rel_time,
+                             std::function<void()> fun) = 0;
+
     /**
      * @brief Removes @p ptr from the list of active writers.
      */
@@ -81,6 +103,14 @@ class middleman {
      */
     void continue_writer(continuable* ptr);
 
+    /**
+     * @brief Adds @p ptr to the list of active writers while it waits for
+     *        a nonblocking connect() to finish. Unlike other writers,
+     *        @p ptr is removed without waiting for it on shutdown.
+     * @warning This member function is not thread-safe.
+     */
+    void continue_connecting(continuable* ptr);
+
     /**
      * @brief Checks wheter @p ptr is an active writer.
      * @warning This member function is not thread-safe.
@@ -143,11 +173,24 @@ class middleman {
     virtual void last_proxy_exited(peer* ptr) = 0;
 
     /**
-     *
+     * @brief Adds a new peer for the connection @p in / @p out to the
+     *        event loop and returns it.
      */
-    virtual void new_peer(const input_stream_ptr& in,
-                          const output_stream_ptr& out,
-                          const node_id_ptr& node = nullptr) = 0;
+    virtual peer* new_peer(const input_stream_ptr& in,
+                           const output_stream_ptr& out,
+                           const node_id_ptr& node = nullptr) = 0;
+
+    /**
+     * @brief Adds a new peer for the outgoing connection @p in / @p out
+     *        to the event loop. The peer performs the handshake with the
+     *        acceptor of the remote node without blocking and invokes
+     *        @p hdl from the event loop once it is done.
+     * @param expected_iface The interface the remote actor must have.
+     */
+    virtual void new_client_peer(const input_stream_ptr& in,
+                                 const output_stream_ptr& out,
+                                 std::set<std::string> expected_iface,
+                                 handshake_handler hdl) = 0;
 
     /**
      * @brief Adds a new acceptor for incoming connections to @p pa
@@ -163,6 +206,13 @@ class middleman {
      */
     inline actor_namespace& get_namespace();
 
+    /**
+     * @brief Returns the resolver performing asynchronous lookups
+     *        for this middleman.
+     * @warning This member function is not thread-safe.
+     */
+    inline resolver& get_resolver();
+
     /**
      * @brief Returns the node of this middleman.
      */
@@ -190,12 +240,21 @@ class middleman {
 
     std::unique_ptr<middleman_event_handler> m_handler;
 
+    std::unique_ptr<resolver> m_resolver;
+
+    // writers added via continue_connecting()
+    std::set<continuable*> m_connecting;
+
 };
 
 inline actor_namespace& middleman::get_namespace() {
     return m_namespace;
 }
 
+inline resolver& middleman::get_resolver() {
+    return *m_resolver;
+}
+
 const node_id_ptr& middleman::node() const {
     CPPA_REQUIRE(m_node != nullptr);
     return m_node;
@@ -62,10 +62,12 @@ class middleman_event_handler {
 
     /**
      * @brief Poll all events.
+     * @param timeout Maximum time to wait for events in milliseconds,
+     *                waits indefinitely if negative.
      */
     template<typename F>
-    void poll(const F& fun) {
-        poll_impl();
+    void poll(const F& fun, int timeout = -1) {
+        poll_impl(timeout);
         for (auto& p : m_events) fun(p.first, p.second);
         m_events.clear();
         update();
@@ -107,8 +109,8 @@ class middleman_event_handler {
 
     middleman_event_handler();
 
-    // fills the event vector
-    virtual void poll_impl() = 0;
+    // fills the event vector, a negative timeout blocks indefinitely
+    virtual void poll_impl(int timeout) = 0;
 
     virtual void handle_event(fd_meta_event me,
                               native_socket_type fd,
@@ -20,6 +20,8 @@
 #ifndef CPPA_IO_OUTPUT_STREAM_HPP
 #define CPPA_IO_OUTPUT_STREAM_HPP
 
+#include <cstddef>
+
 #include "cppa/config.hpp"
 #include "cppa/ref_counted.hpp"
 #include "cppa/intrusive_ptr.hpp"
@@ -27,6 +29,14 @@
 namespace cppa {
 namespace io {
 
+/**
+ * @brief Describes a contiguous chunk of memory used for gather writes.
+ */
+struct io_slice {
+    const void* data;
+    size_t size;
+};
+
 /**
  * @brief An abstract output stream interface.
  */
@@ -57,6 +67,16 @@ class output_stream : public virtual ref_counted {
      */
     virtual size_t write_some(const void* buf, size_t num_bytes) = 0;
 
+    /**
+     * @brief Tries to write the @p num_slices chunks of memory in @p slices
+     *        to the data sink in order, i.e., performs a gather write.
+     * @returns The total number of written bytes.
+     * @throws network_error
+     * @note The default implementation calls {@link write_some()} once
+     *       per slice until a slice was written only partially.
+     */
+    virtual size_t write_some_vec(const io_slice* slices, size_t num_slices);
+
 };
 
 /**
@@ -21,22 +21,34 @@
 #define CPPA_IO_PEER_HPP
 
 #include <map>
+#include <set>
+#include <deque>
+#include <string>
+#include <vector>
+#include <utility>
 #include <cstdint>
+#include <exception>
+#include <unordered_set>
 
 #include "cppa/extend.hpp"
 #include "cppa/node_id.hpp"
 #include "cppa/actor_proxy.hpp"
 #include "cppa/partial_function.hpp"
 #include "cppa/type_lookup_table.hpp"
+#include "cppa/address_lookup_table.hpp"
 #include "cppa/weak_intrusive_ptr.hpp"
 
 #include "cppa/util/buffer.hpp"
+#include "cppa/util/byte_slice.hpp"
 
+#include "cppa/io/middleman.hpp"
 #include "cppa/io/input_stream.hpp"
 #include "cppa/io/output_stream.hpp"
 #include "cppa/io/buffered_writing.hpp"
 #include "cppa/io/default_message_queue.hpp"
 
+namespace cppa { class binary_serializer; }
+
 namespace cppa {
 namespace io {
 
@@ -65,6 +77,20 @@ class peer : public extend<continuable>::with<buffered_writing> {
 
     void enqueue(msg_hdr_cref hdr, const any_tuple& msg);
 
+    /**
+     * @brief Turns this peer into the connecting side of a handshake:
+     *        sends the process information of this node and reads the
+     *        information sent by the peer acceptor of the remote node.
+     *        On Linux, if {@link shm_transport} is enabled, the process
+     *        information is sent only after the remote node turned out
+     *        to run on another host, since the handshake otherwise
+     *        continues on a new connection via shared memory.
+     * @param expected_iface The interface the remote actor must have.
+     * @param hdl Receives the result of the handshake.
+     */
+    void start_handshake(std::set<std::string> expected_iface,
+                         handshake_handler hdl);
+
     inline bool stop_on_last_proxy_exited() const {
         return m_stop_on_last_proxy_exited;
     }
@@ -73,11 +99,47 @@ class peer : public extend<continuable>::with<buffered_writing> {
         return *m_node;
     }
 
+    /**
+     * @brief Returns the number of bytes buffered for this connection,
+     *        i.e., unwritten bytes and the remaining chunks of large
+     *        messages plus an estimate for messages held back until
+     *        those chunks are sent. Messages in the queue of this peer
+     *        are not included.
+     */
+    size_t buffered_bytes() const;
+
+    /**
+     * @brief Serializes queued messages into the write buffer until
+     *        either the queue is empty or the buffered data fills
+     *        the write window.
+     */
+    void flush_queue();
+
+    /**
+     * @brief Sends the feature flags of this node and hashes of all
+     *        announced type names to the remote node.
+     *        Types known to both nodes are assigned IDs up front,
+     *        i.e., no type announcement is needed before using them.
+     */
+    void send_type_dictionary();
+
  private:
 
     enum read_state {
         // connection just established; waiting for process information
         wait_for_process_info,
+        // connected to a peer acceptor; waiting for actor id, process
+        // information and the number of signatures of the remote actor
+        wait_for_handshake,
+        // wait for the size of the next signature of the remote actor
+        wait_for_signature_size,
+        // currently reading a signature of the remote actor
+        read_signature,
+        // wait for the feature flags of the remote node and
+        // the number of entries in its type dictionary
+        wait_for_type_count,
+        // currently reading the type name hashes of the remote node
+        read_type_dictionary,
         // wait for the size of the next message
         wait_for_msg_size,
         // currently reading a message
@@ -87,12 +149,31 @@ class peer : public extend<continuable>::with<buffered_writing> {
     input_stream_ptr m_in;
     read_state m_state;
     node_id_ptr m_node;
+    std::uint32_t m_msg_size;
+    // true if the current frame carries a control message
+    bool m_control_frame;
+    // true if the current frame carries a chunk of a large message
+    bool m_chunk_frame;
+    // false if the current frame was serialized without address aliases
+    bool m_aliased_frame;
+    // true if the content of the current frame is compressed
+    bool m_compressed_frame;
+    // true once the handshake has been written, i.e., once
+    // high-priority messages can use the priority lane
+    bool m_priority_lane_ready;
+    // true if both nodes enabled the compact wire format
+    bool m_compact;
+    // true if the remote node accepts compressed frames
+    bool m_compression_supported;
 
     const uniform_type_info* m_meta_hdr;
     const uniform_type_info* m_meta_msg;
+    const uniform_type_info* m_meta_node;
 
     util::buffer m_rd_buf;
     util::buffer m_wr_buf;
+    // scratch buffer for compressing outgoing frames
+    util::buffer m_compress_buf;
 
     default_message_queue_ptr m_queue;
 
@@ -109,11 +190,108 @@ class peer : public extend<continuable>::with<buffered_writing> {
     // point to the published actor of the remote node
     bool m_stop_on_last_proxy_exited;
 
+    // state of a handshake started by start_handshake()
+    handshake_handler m_handshake_handler;
+    actor_id m_remote_aid;
+    node_id_ptr m_remote_node;
+    std::uint32_t m_pending_signatures;
+    std::set<std::string> m_iface;
+    std::set<std::string> m_expected_iface;
+    bool m_process_info_pending;
+
     partial_function m_content_handler;
 
     type_lookup_table m_incoming_types;
     type_lookup_table m_outgoing_types;
 
+    // interned type names of all messages sent so far,
+    // see detail::interned_tuple_type_names()
+    std::unordered_set<const std::string*> m_sent_type_names;
+
+    // hashes of local type names sent by send_type_dictionary()
+    std::vector<std::pair<std::uint64_t, const uniform_type_info*>>
+    m_local_types;
+
+    address_lookup_table m_incoming_addresses;
+    address_lookup_table m_outgoing_addresses;
+
+    // a large message sent in chunks interleaved with other frames
+    struct outgoing_transfer {
+        std::uint32_t id;
+        actor_addr sender;
+        util::buffer data;
+        size_t pos;
+        // true if data is compressed
+        bool compressed;
+        // later messages of the same sender, held back to keep ordering
+        std::vector<default_message_queue::value_type> backlog;
+    };
+
+    std::uint32_t m_next_transfer_id;
+    std::deque<outgoing_transfer> m_outgoing_transfers;
+
+    // serialized content of a recently sent message, reused when sending
+    // the same tuple to multiple actors on this connection; holding a
+    // reference to the tuple makes sure its content cannot change
+    struct cached_payload {
+        any_tuple msg;
+        bool aliased;
+        std::uint32_t type_table_version;
+        // see address_lookup_table::generation()
+        std::uint32_t alias_generation;
+        util::buffer data;
+    };
+
+    // holds up to max_cached_payloads elements, oldest first
+    std::deque<cached_payload> m_payload_cache;
+
+    // tuples sent once and not cached yet, oldest first; the pointers
+    // are only compared and never dereferenced
+    std::deque<const void*> m_sent_payloads;
+
+    // a partially received chunked message; the final size
+    // of the buffer is the total size of the message
+    struct incoming_transfer {
+        util::buffer data;
+        bool compressed;
+    };
+
+    std::map<std::uint32_t, incoming_transfer> m_incoming_transfers;
+
+    // sum of the total sizes of all partially received messages
+    size_t m_incoming_transfer_bytes;
+
+    bool handle_process_info(const void* buf);
+
+    bool handle_handshake(const void* buf);
+
+    // sends the process information and the type dictionary of this node
+    void send_process_info();
+
+    // moves the handshake to a shared memory connection if
+    // the remote node is another process on the same host
+    bool reconnect_via_shm();
+
+    bool handle_signature(const void* buf, size_t buf_size);
+
+    bool handle_type_dictionary(const void* buf, size_t buf_size);
+
+    bool finalize_handshake();
+
+    void handshake_done(abstract_actor_ptr ptr, std::exception_ptr eptr);
+
+    // @p aliased is false for frames serialized without address aliases,
+    // byte slices of the message refer to @p storage if it is set
+    bool handle_message(const void* buf, size_t buf_size, bool aliased,
+                        util::shared_buffer_ptr storage = nullptr);
+
+    bool handle_chunk(const void* buf, size_t buf_size, bool compressed);
+
+    // decompresses the message in @p buf and calls handle_message()
+    bool handle_compressed(const void* buf, size_t buf_size, bool aliased);
+
+    bool handle_control(const void* buf, size_t buf_size, bool aliased);
+
     void monitor(const actor_addr& sender, const node_id_ptr& node, actor_id aid);
 
     void kill_proxy(const actor_addr& sender, const node_id_ptr& node, actor_id aid, std::uint32_t reason);
@@ -130,7 +308,26 @@ class peer : public extend<continuable>::with<buffered_writing> {
 
     void enqueue_impl(msg_hdr_cref hdr, const any_tuple& msg);
 
-    void add_type_if_needed(const std::string& tname);
+    // serializes a large message without aliases to send it in chunks
+    void enqueue_chunked(msg_hdr_cref hdr, const any_tuple& msg);
+
+    // writes @p msg to @p buf using @p bs or the payload cache
+    void write_payload(binary_serializer& bs, util::buffer& buf,
+                       const any_tuple& msg, bool aliased);
+
+    // returns the cached payload of @p msg serialized for frames
+    // with or without address aliases or nullptr
+    const cached_payload* cached(const any_tuple& msg, bool aliased) const;
+
+    // replaces the content of @p buf following @p offset with its
+    // compressed form if compressing it is enabled and pays off
+    bool compress_frame(util::buffer& buf, size_t offset);
+
+    // writes the next chunks of all pending large messages
+    void write_chunks();
+
+    // @p tname is an interned tuple type name
+    void add_type_if_needed(const std::string* tname);
 
 };
 
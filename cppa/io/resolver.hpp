@@ -0,0 +1,181 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_IO_RESOLVER_HPP
+#define CPPA_IO_RESOLVER_HPP
+
+#include <map>
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+namespace cppa {
+namespace io {
+
+class middleman;
+
+/**
+ * @brief An IPv4 or IPv6 socket address in its native representation,
+ *        i.e., a @p sockaddr_in or a @p sockaddr_in6.
+ */
+class socket_address {
+
+ public:
+
+    socket_address(const void* native_addr, size_t size);
+
+    inline const void* data() const {
+        return m_data.data();
+    }
+
+    inline size_t size() const {
+        return m_data.size();
+    }
+
+    /**
+     * @brief Returns the address family, i.e., @p AF_INET or @p AF_INET6.
+     */
+    int family() const;
+
+    /**
+     * @brief Checks whether this address refers to the local host,
+     *        i.e., is in @p 127.0.0.0/8 or equal to @p ::1.
+     */
+    bool is_loopback() const;
+
+ private:
+
+    std::vector<char> m_data;
+
+};
+
+typedef std::vector<socket_address> socket_address_list;
+
+/**
+ * @brief Receives the result of {@link resolver::async_resolve}, i.e.,
+ *        either a nonempty list of addresses or the error that occurred.
+ */
+typedef std::function<void (socket_address_list, std::exception_ptr)>
+        resolve_handler;
+
+/**
+ * @brief Resolves host names via @p getaddrinfo. Successful lookups are
+ *        cached for {@link resolver::ttl} and the resulting addresses
+ *        alternate between IPv6 and IPv4 (as far as available), starting
+ *        with the family preferred by the system.
+ *
+ * Each middleman owns a resolver that performs asynchronous lookups in
+ * a single helper thread, see {@link middleman::get_resolver}.
+ * @note All static member functions are thread-safe.
+ */
+class resolver {
+
+ public:
+
+    /**
+     * @brief The time a successful lookup remains in the cache.
+     */
+    static constexpr std::chrono::seconds ttl{30};
+
+    /**
+     * @brief The maximum number of hosts waiting to be resolved by
+     *        {@link async_resolve}, further lookups fail immediately.
+     */
+    static constexpr size_t max_pending_lookups = 64;
+
+    /**
+     * @brief Creates a resolver that passes the results of
+     *        {@link async_resolve} to the event loop of @p parent.
+     */
+    resolver(middleman* parent);
+
+    ~resolver();
+
+    /**
+     * @brief Resolves @p host and returns all addresses for TCP
+     *        connections to @p port. Blocks the caller on cache misses.
+     * @throws network_error if @p host cannot be resolved
+     */
+    static socket_address_list resolve(const std::string& host,
+                                       std::uint16_t port);
+
+    /**
+     * @brief Resolves @p host without blocking the caller. On a cache hit,
+     *        @p hdl is invoked immediately. Otherwise, the lookup is queued
+     *        for the helper thread of this resolver and @p hdl is invoked
+     *        from the event loop of the middleman once it is done.
+     *        Concurrent lookups for the same host and port share a single
+     *        call to @p getaddrinfo.
+     * @warning This member function is not thread-safe, i.e., it must be
+     *          called from the event loop of the middleman.
+     */
+    void async_resolve(std::string host,
+                       std::uint16_t port,
+                       resolve_handler hdl);
+
+    /**
+     * @brief Stops the helper thread after its current lookup and waits
+     *        for it. Handlers of pending lookups are never invoked.
+     */
+    void stop();
+
+    /**
+     * @brief Removes all entries from the cache.
+     */
+    static void clear_cache();
+
+ private:
+
+    // executed by m_thread
+    void run();
+
+    // invokes all handlers waiting for @p key, called from the event loop
+    void deliver(const std::string& key,
+                 const socket_address_list& addresses,
+                 std::exception_ptr eptr);
+
+    middleman* m_parent;
+
+    // started on the first lookup that is not cached
+    std::thread m_thread;
+
+    // guards m_stopped and m_queue
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+    bool m_stopped;
+    std::deque<std::pair<std::string, std::uint16_t>> m_queue;
+
+    // handlers waiting for the result of a lookup,
+    // only accessed from the event loop of the middleman
+    std::map<std::string, std::vector<resolve_handler>> m_pending;
+
+};
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_IO_RESOLVER_HPP
@@ -0,0 +1,83 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_IO_SHM_ACCEPTOR_HPP
+#define CPPA_IO_SHM_ACCEPTOR_HPP
+
+#include <memory>
+#include <string>
+
+#include "cppa/config.hpp"
+#include "cppa/node_id.hpp"
+#include "cppa/abstract_actor.hpp"
+
+#include "cppa/io/acceptor.hpp"
+
+#ifdef CPPA_LINUX
+
+namespace cppa {
+namespace io {
+
+/**
+ * @brief An implementation of the {@link acceptor} interface that hands
+ *        out {@link shm_io_stream} connections. Clients connect via
+ *        {@link shm_io_stream::connect_to} to the Unix domain socket
+ *        the acceptor listens on.
+ */
+class shm_acceptor : public acceptor {
+
+ public:
+
+    /**
+     * @brief Creates a Unix domain socket at @p path and accepts
+     *        incoming shared memory connections on it.
+     * @throws network_error if a socket operation fails
+     * @throws bind_failure if another process listens on @p path
+     */
+    static std::unique_ptr<acceptor> create(const std::string& path);
+
+    /**
+     * @brief Returns the abstract Unix domain socket on which @p node
+     *        accepts shared memory connections to its actor @p aid.
+     *        {@link publish} creates this acceptor for each actor.
+     */
+    static std::string endpoint(const node_id& node, actor_id aid);
+
+    ~shm_acceptor();
+
+    native_socket_type file_handle() const override;
+
+    stream_ptr_pair accept_connection() override;
+
+    optional<stream_ptr_pair> try_accept_connection() override;
+
+ private:
+
+    shm_acceptor(std::unique_ptr<acceptor> channel_acceptor);
+
+    std::unique_ptr<acceptor> m_channel_acceptor;
+
+};
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_LINUX
+
+#endif // CPPA_IO_SHM_ACCEPTOR_HPP
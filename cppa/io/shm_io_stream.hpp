@@ -0,0 +1,124 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_IO_SHM_IO_STREAM_HPP
+#define CPPA_IO_SHM_IO_STREAM_HPP
+
+#include <string>
+#include <cstdint>
+
+#include "cppa/config.hpp"
+#include "cppa/io/stream.hpp"
+
+#ifdef CPPA_LINUX
+
+namespace cppa {
+namespace io {
+
+struct shm_ring;
+class middleman;
+
+/**
+ * @brief An implementation of the {@link stream} interface for processes
+ *        on the same host that transfers data via two single-producer,
+ *        single-consumer ring buffers in shared memory (one per direction).
+ *
+ * Both processes remain connected via a Unix domain socket, which is used
+ * to exchange the file descriptors of the shared memory, to wake up a
+ * sleeping reader, and to detect when the other process closes the
+ * connection. A writer that runs out of space in the ring buffer waits
+ * for an eventfd the reader signals once it consumed data.
+ */
+class shm_io_stream : public stream {
+
+ public:
+
+    ~shm_io_stream();
+
+    /**
+     * @brief Connects to the {@link shm_acceptor} at @p path.
+     * @throws network_error if connection fails
+     */
+    static stream_ptr connect_to(const std::string& path);
+
+    /**
+     * @brief Receives the shared memory {@link accept_from} sends via
+     *        @p channel and returns the client side of the new stream.
+     * @returns The new stream or @p nullptr if @p channel
+     *          did not receive the shared memory yet.
+     * @throws network_error if @p channel is closed or a system call fails
+     */
+    static stream_ptr try_connect(const stream_ptr& channel);
+
+    /**
+     * @brief Waits without blocking until @p channel received the shared
+     *        memory sent by {@link accept_from}. The event loop of
+     *        @p parent invokes @p hdl with the new stream or the
+     *        error that occurred.
+     * @note Must be called from the event loop of @p parent.
+     */
+    static void async_connect(middleman* parent, stream_ptr channel,
+                              connect_handler hdl);
+
+    /**
+     * @brief Creates the shared memory for the connection @p channel,
+     *        sends it to the client and returns the server side of the
+     *        new stream.
+     * @throws network_error if a system call fails
+     */
+    static stream_ptr accept_from(stream_ptr channel);
+
+    native_socket_type read_handle() const;
+
+    native_socket_type write_handle() const;
+
+    void read(void* buf, size_t len);
+
+    size_t read_some(void* buf, size_t len);
+
+    void write(const void* buf, size_t len);
+
+    size_t write_some(const void* buf, size_t len);
+
+ private:
+
+    shm_io_stream(stream_ptr channel, void* mem, int tx_efd, int rx_efd,
+                  bool is_server);
+
+    // drains pending wakeup notifications from m_channel
+    void drain_channel();
+
+    stream_ptr m_channel;
+    void* m_mem;
+    // signals free space in m_tx to this process
+    int m_tx_efd;
+    // signals free space in m_rx to the other process
+    int m_rx_efd;
+    shm_ring* m_tx;
+    shm_ring* m_rx;
+    bool m_channel_closed;
+
+};
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_LINUX
+
+#endif // CPPA_IO_SHM_IO_STREAM_HPP
@@ -20,6 +20,9 @@
 #ifndef CPPA_IO_STREAM_HPP
 #define CPPA_IO_STREAM_HPP
 
+#include <exception>
+#include <functional>
+
 #include "cppa/io/input_stream.hpp"
 #include "cppa/io/output_stream.hpp"
 
@@ -42,6 +45,14 @@ class stream : public input_stream, public output_stream {
  */
 typedef intrusive_ptr<stream> stream_ptr;
 
+/**
+ * @brief Receives the result of an asynchronous connect, e.g.,
+ *        {@link tcp_io_stream::async_connect}, i.e., either the
+ *        connected stream or the error that occurred.
+ */
+typedef std::function<void (stream_ptr, std::exception_ptr)>
+        connect_handler;
+
 } // namespace io
 } // namespace cppa
 
@@ -38,9 +38,10 @@ class tcp_acceptor : public acceptor {
 
     /**
      * @brief Creates an TCP acceptor and binds it to given @p port. Incoming
-     *        connections are only accepted from the address @p addr.
+     *        connections are only accepted from the address @p addr,
+     *        which is either an IPv4 or an IPv6 address.
      *        Per default, i.e., <tt>addr == nullptr</tt>, all incoming
-     *        connections are accepted.
+     *        IPv4 and IPv6 connections are accepted.
      * @throws network_error if a socket operation fails
      * @throws bind_failure if given port is already in use
      */
@@ -22,10 +22,13 @@
 
 #include "cppa/config.hpp"
 #include "cppa/io/stream.hpp"
+#include "cppa/io/resolver.hpp"
 
 namespace cppa {
 namespace io {
 
+class middleman;
+
 /**
  * @brief An implementation of the {@link stream} interface for TCP sockets.
  */
@@ -37,10 +40,25 @@ class tcp_io_stream : public stream {
 
     /**
      * @brief Establishes a TCP connection to given @p host at given @p port.
+     *        If @p host resolves to multiple addresses, connection
+     *        attempts to all of them overlap as described in RFC 6555.
+     *        On Windows, the addresses are tried one after another.
      * @throws network_error if connection fails or read error occurs
      */
     static stream_ptr connect_to(const char* host, std::uint16_t port);
 
+    /**
+     * @brief Connects to the first reachable address in @p addrs without
+     *        blocking. Connection attempts overlap as in {@link connect_to}
+     *        and are driven by the event loop of @p parent, which invokes
+     *        @p hdl once a connection has been established or all
+     *        attempts failed.
+     * @note Must be called from the event loop of @p parent.
+     */
+    static void async_connect(middleman* parent,
+                              socket_address_list addrs,
+                              connect_handler hdl);
+
     /**
      * @brief Creates an TCP stream from the native socket handle @p fd.
      */
@@ -58,10 +76,14 @@ class tcp_io_stream : public stream {
 
     size_t write_some(const void* buf, size_t len);
 
- private:
+    size_t write_some_vec(const io_slice* slices, size_t num_slices);
+
+ protected:
 
     tcp_io_stream(native_socket_type fd);
 
+ private:
+
     native_socket_type m_fd;
 
 };
@@ -0,0 +1,75 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_IO_UNIX_ACCEPTOR_HPP
+#define CPPA_IO_UNIX_ACCEPTOR_HPP
+
+#include <memory>
+#include <string>
+
+#include "cppa/config.hpp"
+#include "cppa/io/acceptor.hpp"
+
+#ifndef CPPA_WINDOWS
+
+namespace cppa {
+namespace io {
+
+/**
+ * @brief An implementation of the {@link acceptor} interface for
+ *        Unix domain sockets.
+ */
+class unix_acceptor : public acceptor {
+
+ public:
+
+    /**
+     * @brief Creates a Unix domain socket at @p path and accepts incoming
+     *        connections on it. A stale socket file at @p path, i.e., a
+     *        file no process is listening on, is replaced. The socket file
+     *        is removed once the acceptor is destroyed.
+     * @throws network_error if a socket operation fails
+     * @throws bind_failure if another process listens on @p path
+     */
+    static std::unique_ptr<acceptor> create(const std::string& path);
+
+    ~unix_acceptor();
+
+    native_socket_type file_handle() const override;
+
+    stream_ptr_pair accept_connection() override;
+
+    optional<stream_ptr_pair> try_accept_connection() override;
+
+ private:
+
+    unix_acceptor(native_socket_type fd, std::string path);
+
+    native_socket_type m_fd;
+    bool m_is_nonblocking;
+    std::string m_path;
+
+};
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_WINDOWS
+
+#endif // CPPA_IO_UNIX_ACCEPTOR_HPP
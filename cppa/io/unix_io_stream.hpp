@@ -0,0 +1,65 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_IO_UNIX_IO_STREAM_HPP
+#define CPPA_IO_UNIX_IO_STREAM_HPP
+
+#include <string>
+
+#include "cppa/config.hpp"
+#include "cppa/io/tcp_io_stream.hpp"
+
+#ifndef CPPA_WINDOWS
+
+namespace cppa {
+namespace io {
+
+/**
+ * @brief An implementation of the {@link stream} interface for
+ *        Unix domain sockets, i.e., for connections between
+ *        processes on the same host.
+ */
+class unix_io_stream : public tcp_io_stream {
+
+ public:
+
+    /**
+     * @brief Establishes a connection to the Unix domain socket at @p path.
+     * @throws network_error if connection fails
+     */
+    static stream_ptr connect_to(const std::string& path);
+
+    /**
+     * @brief Creates a stream from the native socket handle @p fd
+     *        of a connected Unix domain socket.
+     */
+    static stream_ptr from_sockfd(native_socket_type fd);
+
+ private:
+
+    unix_io_stream(native_socket_type fd);
+
+};
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_WINDOWS
+
+#endif // CPPA_IO_UNIX_IO_STREAM_HPP
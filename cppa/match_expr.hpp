@@ -38,6 +38,7 @@
 #include "cppa/detail/value_guard.hpp"
 #include "cppa/detail/tuple_dummy.hpp"
 #include "cppa/detail/pseudo_tuple.hpp"
+#include "cppa/detail/meta_cow_tuple.hpp"
 #include "cppa/detail/behavior_impl.hpp"
 
 namespace cppa {
@@ -816,6 +817,10 @@ class match_expr {
         m_cache.resize(cache_size);
         for (auto& entry : m_cache) { entry.first = nullptr; }
         m_cache_begin = m_cache_end = 0;
+        // remote messages matching a statically typed pattern can use
+        // the type token of local messages and thus our cache as well
+        int hints[] = {(detail::tuple_hint<typename Cs::pattern_type>::add(), 0)...};
+        static_cast<void>(hints);
     }
 
     template<class Tuple>
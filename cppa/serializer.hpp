@@ -23,6 +23,7 @@
 #include <string>
 #include <cstddef> // size_t
 
+#include "cppa/primitive_type.hpp"
 #include "cppa/uniform_type_info.hpp"
 #include "cppa/detail/to_uniform_name.hpp"
 
@@ -31,6 +32,7 @@ namespace cppa {
 class actor_namespace;
 class primitive_variant;
 class type_lookup_table;
+class address_lookup_table;
 
 /**
  * @ingroup TypeSystem
@@ -47,7 +49,8 @@ class serializer {
      * @note @p addressing must be guaranteed to outlive the serializer
      */
     serializer(actor_namespace* addressing = nullptr,
-               type_lookup_table* outgoing_types = nullptr);
+               type_lookup_table* outgoing_types = nullptr,
+               address_lookup_table* outgoing_addresses = nullptr);
 
     virtual ~serializer();
 
@@ -91,6 +94,23 @@ class serializer {
      */
     virtual void write_tuple(size_t num, const primitive_variant* values) = 0;
 
+    /**
+     * @brief Writes the elements of a sequence of @p num values of the
+     *        arithmetic type @p ptype stored contiguously at @p values.
+     * @note The default implementation calls {@link write_value()}
+     *       for each element.
+     */
+    virtual void write_values(primitive_type ptype, size_t num,
+                              const void* values);
+
+    /**
+     * @brief Returns whether {@link write_raw()} produces the same output
+     *        as {@link write_value()} for a sequence of integers in host
+     *        byte order and IEEE-754 packed floating point values.
+     *        Type information objects may write such values as one block.
+     */
+    virtual bool native_layout() const;
+
     inline actor_namespace* get_namespace() {
         return m_namespace;
     }
@@ -99,10 +119,15 @@ class serializer {
         return m_outgoing_types;
     }
 
+    inline address_lookup_table* outgoing_addresses() {
+        return m_outgoing_addresses;
+    }
+
  private:
 
     actor_namespace* m_namespace;
     type_lookup_table* m_outgoing_types;
+    address_lookup_table* m_outgoing_addresses;
 
 };
 
@@ -95,6 +95,21 @@ struct sync_exited_msg {
     std::uint32_t reason;
 };
 
+/**
+ * @brief Sent to a local actor whenever a message it sent to a remote actor
+ *        was dropped, because the connection to the remote node is congested.
+ *
+ * Synchronous requests are answered with this message instead, i.e.,
+ * the request fails. Whether a connection is congested is controlled by
+ * {@link peer_buffer_watermarks()}.
+ */
+struct peer_congested_msg {
+    /**
+     * @brief The source of this message, i.e., the intended receiver.
+     */
+    actor_addr source;
+};
+
 /**
  * @brief Signalizes a timeout event.
  * @note This message is handled implicitly by the runtime system.
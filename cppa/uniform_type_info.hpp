@@ -21,6 +21,7 @@
 #define CPPA_UNIFORM_TYPE_INFO_HPP
 
 #include <map>
+#include <atomic>
 #include <vector>
 #include <string>
 #include <cstdint>
@@ -257,7 +258,15 @@ class uniform_type_info {
  */
 template<typename T>
 inline const uniform_type_info* uniform_typeid() {
-    return uniform_typeid(typeid(T));
+    // uniform_type_info instances are singletons, i.e., the result
+    // of a successful lookup never changes (failed lookups throw)
+    static std::atomic<const uniform_type_info*> cache{nullptr};
+    auto result = cache.load(std::memory_order_relaxed);
+    if (result == nullptr) {
+        result = uniform_typeid(typeid(T));
+        cache.store(result, std::memory_order_relaxed);
+    }
+    return result;
 }
 
 /**
@@ -103,7 +103,8 @@ class buffer {
     inline size_t final_size() const;
 
     /**
-     * @brief Sets the buffer's final size to @p new_value.
+     * @brief Sets the buffer's final size to @p new_value. Data that
+     *        was already written to the buffer is preserved.
      * @throws std::invalid_argument if <tt>new_value > maximum_size()</tt>.
      */
     void final_size(size_t new_value);
@@ -0,0 +1,147 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_UTIL_BYTE_SLICE_HPP
+#define CPPA_UTIL_BYTE_SLICE_HPP
+
+#include <string>
+#include <cstddef>
+
+#include "cppa/ref_counted.hpp"
+#include "cppa/intrusive_ptr.hpp"
+
+#include "cppa/util/buffer.hpp"
+#include "cppa/util/comparable.hpp"
+
+namespace cppa {
+namespace util {
+
+/**
+ * @brief A reference counted buffer that keeps the memory
+ *        of one or more {@link byte_slice byte slices} alive.
+ */
+class shared_buffer : public ref_counted {
+
+ public:
+
+    shared_buffer() = default;
+
+    inline explicit shared_buffer(buffer&& buf) : m_buf(std::move(buf)) { }
+
+    inline const buffer& get() const {
+        return m_buf;
+    }
+
+    inline buffer& get() {
+        return m_buf;
+    }
+
+ private:
+
+    buffer m_buf;
+
+};
+
+typedef intrusive_ptr<shared_buffer> shared_buffer_ptr;
+
+/**
+ * @brief An immutable view to a sequence of bytes.
+ *
+ * A slice either owns a private copy of its bytes or refers to a range
+ * of a {@link shared_buffer}, e.g., the frame a message was received in.
+ * Copying a slice never copies the bytes it refers to.
+ */
+class byte_slice : comparable<byte_slice> {
+
+ public:
+
+    typedef const char* const_iterator;
+
+    /**
+     * @brief Creates an empty slice.
+     */
+    byte_slice();
+
+    /**
+     * @brief Creates a slice holding a copy of the first
+     *        @p num_bytes bytes of @p data.
+     */
+    byte_slice(const void* data, size_t num_bytes);
+
+    /**
+     * @brief Creates a slice holding a copy of @p str.
+     */
+    explicit byte_slice(const std::string& str);
+
+    /**
+     * @brief Creates a slice referring to @p num_bytes bytes at
+     *        @p data without copying them.
+     * @pre The range <tt>[data, data + num_bytes)</tt> is part
+     *      of the buffer managed by @p storage.
+     */
+    byte_slice(shared_buffer_ptr storage, const void* data, size_t num_bytes);
+
+    inline const char* data() const {
+        return m_data;
+    }
+
+    inline size_t size() const {
+        return m_size;
+    }
+
+    inline bool empty() const {
+        return m_size == 0;
+    }
+
+    inline const_iterator begin() const {
+        return m_data;
+    }
+
+    inline const_iterator end() const {
+        return m_data + m_size;
+    }
+
+    /**
+     * @brief Returns the buffer this slice refers to.
+     */
+    inline const shared_buffer_ptr& storage() const {
+        return m_storage;
+    }
+
+    /**
+     * @brief Returns a copy of the referenced bytes as string.
+     */
+    inline std::string str() const {
+        return std::string(m_data, m_size);
+    }
+
+    int compare(const byte_slice& other) const;
+
+ private:
+
+    shared_buffer_ptr m_storage;
+    const char* m_data;
+    size_t m_size;
+
+};
+
+} // namespace util
+} // namespace cppa
+
+#endif // CPPA_UTIL_BYTE_SLICE_HPP
@@ -0,0 +1,53 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#ifndef CPPA_UTIL_COMPRESSION_HPP
+#define CPPA_UTIL_COMPRESSION_HPP
+
+#include <cstddef>
+
+#include "cppa/util/buffer.hpp"
+
+namespace cppa {
+namespace util {
+
+/**
+ * @brief Compresses @p size bytes from @p data using a fast LZ77 variant
+ *        and appends the result to @p storage.
+ *
+ * The output starts with the size of the original data as 32 bit integer,
+ * followed by a sequence of literal runs and back references to data
+ * at most 64 KB before the current position.
+ * @returns The number of bytes appended to @p storage.
+ */
+size_t compress(const void* data, size_t size, buffer& storage);
+
+/**
+ * @brief Decompresses @p size bytes from @p data produced by
+ *        {@link compress()} and appends the result to @p storage.
+ * @returns @p false if @p data is malformed or if the decompressed
+ *          data would exceed @p max_size bytes, @p true otherwise.
+ */
+bool decompress(const void* data, size_t size, buffer& storage,
+                size_t max_size);
+
+} // namespace util
+} // namespace cppa
+
+#endif // CPPA_UTIL_COMPRESSION_HPP
@@ -17,11 +17,83 @@
 \******************************************************************************/
 
 
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+
+#include "cppa/util/shared_spinlock.hpp"
+#include "cppa/util/shared_lock_guard.hpp"
+#include "cppa/util/upgrade_lock_guard.hpp"
+
 #include "cppa/detail/abstract_tuple.hpp"
 
 namespace cppa {
 namespace detail {
 
+namespace {
+
+typedef util::shared_lock_guard<util::shared_spinlock> shared_guard;
+typedef util::upgrade_lock_guard<util::shared_spinlock> upgrade_guard;
+
+struct interned_names {
+    std::vector<const uniform_type_info*> types;
+    std::string names;
+};
+
+class interned_names_table {
+
+ public:
+
+    const std::string* get(const abstract_tuple& tup) {
+        auto hash = hash_of(tup);
+        shared_guard guard(m_lock);
+        auto result = find(hash, tup);
+        if (result) return result;
+        upgrade_guard uguard(guard);
+        // another thread might have inserted the names in the meantime
+        result = find(hash, tup);
+        if (result) return result;
+        interned_names entry;
+        for (auto i = tup.begin(); i != tup.end(); ++i) {
+            entry.types.push_back(i.type());
+        }
+        entry.names = get_tuple_type_names(tup);
+        // references to elements of unordered containers remain valid
+        return &(m_data.emplace(hash, std::move(entry))->second.names);
+    }
+
+ private:
+
+    static size_t hash_of(const abstract_tuple& tup) {
+        std::hash<const void*> h;
+        auto result = tup.size();
+        for (auto i = tup.begin(); i != tup.end(); ++i) {
+            result = result * 31 + h(i.type());
+        }
+        return result;
+    }
+
+    const std::string* find(size_t hash, const abstract_tuple& tup) const {
+        auto range = m_data.equal_range(hash);
+        for (auto i = range.first; i != range.second; ++i) {
+            auto& types = i->second.types;
+            if (   types.size() == tup.size()
+                && std::equal(types.begin(), types.end(), tup.begin(),
+                              types_only_eq)) {
+                return &(i->second.names);
+            }
+        }
+        return nullptr;
+    }
+
+    util::shared_spinlock m_lock;
+    std::unordered_multimap<size_t, interned_names> m_data;
+
+};
+
+} // namespace <anonymous>
+
 abstract_tuple::abstract_tuple(bool is_dynamic) : m_is_dynamic(is_dynamic) { }
 
 bool abstract_tuple::equals(const abstract_tuple &other) const {
@@ -55,6 +127,11 @@ std::string get_tuple_type_names(const detail::abstract_tuple& tup) {
     return result;
 }
 
+const std::string* interned_tuple_type_names(const abstract_tuple& tup) {
+    static interned_names_table table;
+    return table.get(tup);
+}
+
 } // namespace detail
 } // namespace cppa
 
@@ -18,6 +18,7 @@
 
 
 #include <utility>
+#include <stdexcept>
 
 #include "cppa/logging.hpp"
 #include "cppa/node_id.hpp"
@@ -25,6 +26,7 @@
 #include "cppa/singletons.hpp"
 #include "cppa/deserializer.hpp"
 #include "cppa/actor_namespace.hpp"
+#include "cppa/address_lookup_table.hpp"
 
 #include "cppa/io/middleman.hpp"
 #include "cppa/io/remote_actor_proxy.hpp"
@@ -34,47 +36,128 @@
 
 namespace cppa {
 
+namespace {
+
+// an alias of 0 identifies an invalid actor
+constexpr std::uint32_t invalid_alias = 0;
+
+// marks an address that is transmitted in full and not aliased
+constexpr std::uint32_t no_alias = 0xFFFFFFFF;
+
+// marks the definition of a new alias, followed by the full address
+constexpr std::uint32_t new_alias_flag = 0x80000000;
+
+void write_node(serializer* sink, const node_id& node,
+                std::uint32_t alias, bool is_new) {
+    if (alias != 0 && !is_new) {
+        sink->write_value(alias);
+        return;
+    }
+    sink->write_value(alias != 0 ? alias | new_alias_flag : no_alias);
+    sink->write_value(node.process_id());
+    sink->write_raw(node_id::host_id_size, node.host_id().data());
+}
+
+node_id_ptr read_node(deserializer* source, address_lookup_table* tbl) {
+    auto key = source->read<uint32_t>();
+    if ((key & new_alias_flag) == 0) {
+        auto result = tbl->node_by_alias(key);
+        if (!result) throw std::runtime_error("unknown node alias");
+        return result;
+    }
+    node_id::host_id_type hid;
+    auto pid = source->read<uint32_t>();
+    source->read_raw(node_id::host_id_size, hid.data());
+    node_id_ptr result = new node_id{pid, hid};
+    if (key != no_alias) tbl->emplace_node(key & ~new_alias_flag, result);
+    return result;
+}
+
+} // namespace <anonymous>
+
 void actor_namespace::write(serializer* sink, const actor_addr& addr) {
     CPPA_REQUIRE(sink != nullptr);
+    auto tbl = sink->outgoing_addresses();
     if (!addr) {
+        if (tbl) {
+            sink->write_value(invalid_alias);
+            return;
+        }
         node_id::host_id_type zero;
         std::fill(zero.begin(), zero.end(), 0);
         sink->write_value(static_cast<uint32_t>(0));         // actor id
         sink->write_value(static_cast<uint32_t>(0));         // process id
         sink->write_raw(node_id::host_id_size, zero.data()); // host id
+        return;
     }
-    else {
-        // register locally running actors to be able to deserialize them later
-        if (!addr.is_remote()) {
-            get_actor_registry()->put(addr.id(), detail::raw_access::get(addr));
+    // register locally running actors to be able to deserialize them later
+    if (!addr.is_remote()) {
+        get_actor_registry()->put(addr.id(), detail::raw_access::get(addr));
+    }
+    auto& pinf = addr.node();
+    if (tbl) {
+        bool new_actor = false;
+        auto actor_alias = tbl->actor_alias(pinf, addr.id(), new_actor);
+        if (!new_actor) {
+            sink->write_value(actor_alias);
+            return;
         }
-        auto& pinf = addr.node();
-        sink->write_value(addr.id());                                  // actor id
-        sink->write_value(pinf.process_id());                          // process id
-        sink->write_raw(node_id::host_id_size, pinf.host_id().data()); // host id
+        // the node alias is only assigned if the node is actually written,
+        // otherwise the receiver would never learn a new node alias
+        bool new_node = false;
+        auto node_alias = tbl->node_alias(pinf, new_node);
+        sink->write_value(actor_alias | new_alias_flag);
+        sink->write_value(addr.id());
+        write_node(sink, pinf, node_alias, new_node);
+        return;
     }
+    sink->write_value(addr.id());                                  // actor id
+    sink->write_value(pinf.process_id());                          // process id
+    sink->write_raw(node_id::host_id_size, pinf.host_id().data()); // host id
 }
 
 actor_addr actor_namespace::read(deserializer* source) {
     CPPA_REQUIRE(source != nullptr);
+    auto tbl = source->incoming_addresses();
+    if (tbl) {
+        auto key = source->read<uint32_t>();
+        if (key == invalid_alias) return invalid_actor_addr;
+        if ((key & new_alias_flag) == 0) {
+            auto entry = tbl->actor_by_alias(key);
+            if (!entry.first) throw std::runtime_error("unknown actor alias");
+            return resolve(entry.first, entry.second);
+        }
+        auto aid = source->read<uint32_t>();
+        auto node = read_node(source, tbl);
+        if (key != no_alias) tbl->emplace_actor(key & ~new_alias_flag,
+                                                node, aid);
+        return resolve(node, aid);
+    }
     node_id::host_id_type hid;
     auto aid = source->read<uint32_t>();                 // actor id
     auto pid = source->read<uint32_t>();                 // process id
     source->read_raw(node_id::host_id_size, hid.data()); // host id
-    auto this_node = get_middleman()->node();
     if (aid == 0 && pid == 0) {
         // 0:0 identifies an invalid actor
         return invalid_actor_addr;
     }
-    else if (pid == this_node->process_id() && hid == this_node->host_id()) {
+    return resolve(new node_id{pid, hid}, aid);
+}
+
+actor_addr actor_namespace::resolve(const node_id_ptr& node, actor_id aid) {
+    auto this_node = get_middleman()->node();
+    if (*node == *this_node) {
         // identifies this exact process on this host, ergo: local actor
-        return get_actor_registry()->get(aid)->address();
-    }
-    else {
-        // identifies a remote actor; create proxy if needed
-        node_id_ptr tmp = new node_id{pid, hid};
-        return get_or_put(tmp, aid)->address();
+        auto ptr = get_actor_registry()->get(aid);
+        if (!ptr) {
+            CPPA_LOG_INFO("received address of a local actor that "
+                          "already finished execution: " << aid);
+            return invalid_actor_addr;
+        }
+        return ptr->address();
     }
+    // identifies a remote actor; create proxy if needed
+    return get_or_put(node, aid)->address();
 }
 
 size_t actor_namespace::count_proxies(const node_id& node) {
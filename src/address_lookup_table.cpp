@@ -0,0 +1,127 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <utility>
+#include <stdexcept>
+
+#include "cppa/address_lookup_table.hpp"
+
+namespace cppa {
+
+namespace {
+
+template<typename Map>
+bool erase_greater(Map& aliases, std::uint32_t max_alias) {
+    auto size = aliases.size();
+    for (auto i = aliases.begin(); i != aliases.end(); ) {
+        if (i->second > max_alias) i = aliases.erase(i);
+        else ++i;
+    }
+    return size != aliases.size();
+}
+
+template<typename Map, typename Key>
+std::uint32_t get_alias(Map& aliases, const Key& key, bool& is_new) {
+    is_new = false;
+    auto i = aliases.find(key);
+    if (i != aliases.end()) return i->second;
+    auto alias = static_cast<std::uint32_t>(aliases.size() + 1);
+    aliases.emplace(key, alias);
+    is_new = true;
+    return alias;
+}
+
+template<typename Vector, typename... Ts>
+void emplace_alias(Vector& entries, std::uint32_t alias, const char* what,
+                   Ts&&... args) {
+    if (alias == 1) {
+        // the sending side discarded all of its aliases
+        entries.clear();
+    }
+    else if (   alias != entries.size() + 1
+             || alias > address_lookup_table::max_aliases) {
+        throw std::runtime_error(what);
+    }
+    entries.emplace_back(std::forward<Ts>(args)...);
+}
+
+} // namespace <anonymous>
+
+address_lookup_table::address_lookup_table() : m_generation(0) { }
+
+std::uint32_t address_lookup_table::node_alias(const node_id& node,
+                                               bool& is_new) {
+    node_key key{node.process_id(), node.host_id()};
+    if (   m_node_aliases.size() >= max_aliases
+        && m_node_aliases.count(key) == 0) {
+        reset_sending_side(true, false);
+    }
+    return get_alias(m_node_aliases, key, is_new);
+}
+
+std::uint32_t address_lookup_table::actor_alias(const node_id& node,
+                                                actor_id aid,
+                                                bool& is_new) {
+    actor_key key{node_key{node.process_id(), node.host_id()}, aid};
+    if (   m_actor_aliases.size() >= max_aliases
+        && m_actor_aliases.count(key) == 0) {
+        reset_sending_side(false, true);
+    }
+    return get_alias(m_actor_aliases, key, is_new);
+}
+
+void address_lookup_table::emplace_node(std::uint32_t alias,
+                                        node_id_ptr node) {
+    emplace_alias(m_nodes, alias, "invalid node alias", std::move(node));
+}
+
+void address_lookup_table::emplace_actor(std::uint32_t alias,
+                                         node_id_ptr node,
+                                         actor_id aid) {
+    emplace_alias(m_actors, alias, "invalid actor alias", std::move(node), aid);
+}
+
+node_id_ptr address_lookup_table::node_by_alias(std::uint32_t alias) const {
+    if (alias == 0 || alias > m_nodes.size()) return nullptr;
+    return m_nodes[alias - 1];
+}
+
+std::pair<node_id_ptr, actor_id>
+address_lookup_table::actor_by_alias(std::uint32_t alias) const {
+    if (alias == 0 || alias > m_actors.size()) return {nullptr, 0};
+    return m_actors[alias - 1];
+}
+
+void address_lookup_table::truncate(const checkpoint& cp) {
+    if (cp.generation != m_generation) {
+        reset_sending_side(true, true);
+        return;
+    }
+    auto nodes = erase_greater(m_node_aliases, cp.nodes);
+    auto actors = erase_greater(m_actor_aliases, cp.actors);
+    if (nodes || actors) ++m_generation;
+}
+
+void address_lookup_table::reset_sending_side(bool nodes, bool actors) {
+    if (nodes) m_node_aliases.clear();
+    if (actors) m_actor_aliases.clear();
+    ++m_generation;
+}
+
+} // namespace cppa
@@ -17,6 +17,7 @@
 \******************************************************************************/
 
 
+#include <limits>
 #include <string>
 #include <cstdint>
 #include <cstring>
@@ -57,8 +58,6 @@ inline void range_check(pointer begin, pointer end, size_t read_size) {
     }
 }
 
-pointer read_range(pointer begin, pointer end, string& storage);
-
 template<typename T>
 pointer read_range(pointer begin, pointer end, T& storage,
                    typename enable_if<is_integral<T>::value>::type* = 0) {
@@ -76,19 +75,54 @@ pointer read_range(pointer begin, pointer end, T& storage,
     return result;
 }
 
-// the IEEE-754 conversion does not work for long double
-// => fall back to string serialization (event though it sucks)
-pointer read_range(pointer begin, pointer end, long double& storage) {
-    std::string tmp;
-    auto result = read_range(begin, end, tmp);
-    std::istringstream iss{std::move(tmp)};
-    iss >> storage;
-    return result;
+// reads a LEB128 encoded integer
+pointer read_varint(pointer begin, pointer end, uint64_t& storage) {
+    storage = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        range_check(begin, end, 1);
+        auto byte = *reinterpret_cast<const uint8_t*>(begin);
+        begin = advanced(begin, 1);
+        // the 10th byte holds only the most significant bit
+        if (shift == 63 && byte > 1) break;
+        storage |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return begin;
+    }
+    throw runtime_error("binary_deserializer: malformed varint");
+}
+
+template<typename T>
+T from_varint(uint64_t value, typename enable_if<is_signed<T>::value>::type* = 0) {
+    // reverse zigzag encoding
+    auto x =   static_cast<int64_t>(value >> 1)
+             ^ -static_cast<int64_t>(value & 1);
+    if (x < numeric_limits<T>::min() || x > numeric_limits<T>::max()) {
+        throw runtime_error("binary_deserializer: integer out of range");
+    }
+    return static_cast<T>(x);
+}
+
+template<typename T>
+T from_varint(uint64_t value, typename enable_if<!is_signed<T>::value>::type* = 0) {
+    if (value > numeric_limits<T>::max()) {
+        throw runtime_error("binary_deserializer: integer out of range");
+    }
+    return static_cast<T>(value);
+}
+
+// reads an integer in either the fixed-size or the compact format
+template<typename T>
+pointer read_int(pointer begin, pointer end, bool compact, T& storage) {
+    if (!compact || sizeof(T) == 1) return read_range(begin, end, storage);
+    uint64_t tmp;
+    begin = read_varint(begin, end, tmp);
+    storage = from_varint<T>(tmp);
+    return begin;
 }
 
-pointer read_range(pointer begin, pointer end, string& storage) {
+pointer read_string(pointer begin, pointer end, bool compact,
+                    string& storage) {
     uint32_t str_size;
-    begin = read_range(begin, end, str_size);
+    begin = read_int(begin, end, compact, str_size);
     range_check(begin, end, str_size);
     storage.clear();
     storage.reserve(str_size);
@@ -98,69 +132,135 @@ pointer read_range(pointer begin, pointer end, string& storage) {
 }
 
 template<typename CharType, typename StringType>
-pointer read_unicode_string(pointer begin, pointer end, StringType& str) {
+pointer read_unicode_string(pointer begin, pointer end, bool compact,
+                            StringType& str) {
     uint32_t str_size;
-    begin = read_range(begin, end, str_size);
-    str.reserve(str_size);
+    begin = read_int(begin, end, compact, str_size);
+    range_check(begin, end, str_size * sizeof(CharType));
+    str.resize(str_size);
+    if (sizeof(typename StringType::value_type) == sizeof(CharType)) {
+        memcpy(&str[0], begin, str_size * sizeof(CharType));
+        return advanced(begin, str_size * sizeof(CharType));
+    }
     for (size_t i = 0; i < str_size; ++i) {
         CharType c;
         begin = read_range(begin, end, c);
-        str += static_cast<typename StringType::value_type>(c);
+        str[i] = static_cast<typename StringType::value_type>(c);
     }
     return begin;
 }
 
-pointer read_range(pointer begin, pointer end, atom_value& storage) {
-    std::uint64_t tmp;
-    auto result = read_range(begin, end, tmp);
-    storage = static_cast<atom_value>(tmp);
-    return result;
-}
-
-pointer read_range(pointer begin, pointer end, u16string& storage) {
-    // char16_t is guaranteed to has *at least* 16 bytes,
-    // but not to have *exactly* 16 bytes; thus use uint16_t
-    return read_unicode_string<uint16_t>(begin, end, storage);
+template<typename T>
+pointer read_packed(pointer begin, pointer end, size_t num, T* storage) {
+    typedef typename detail::ieee_754_trait<T>::packed_type packed_type;
+    range_check(begin, end, num * sizeof(packed_type));
+    for (size_t i = 0; i < num; ++i) {
+        packed_type tmp;
+        memcpy(&tmp, begin, sizeof(packed_type));
+        storage[i] = detail::unpack754(tmp);
+        begin = advanced(begin, sizeof(packed_type));
+    }
+    return begin;
 }
 
-pointer read_range(pointer begin, pointer end, u32string& storage) {
-    // char32_t is guaranteed to has *at least* 32 bytes,
-    // but not to have *exactly* 32 bytes; thus use uint32_t
-    return read_unicode_string<uint32_t>(begin, end, storage);
+template<typename T>
+pointer read_ints(pointer begin, pointer end, bool compact,
+                  size_t num, void* storage) {
+    auto first = static_cast<T*>(storage);
+    if (!compact || sizeof(T) == 1) {
+        range_check(begin, end, num * sizeof(T));
+        memcpy(first, begin, num * sizeof(T));
+        return advanced(begin, num * sizeof(T));
+    }
+    for (auto i = first; i != first + num; ++i) {
+        begin = read_int(begin, end, compact, *i);
+    }
+    return begin;
 }
 
 struct pt_reader {
 
     pointer begin;
     pointer end;
+    bool compact;
 
-    pt_reader(pointer bbegin, pointer bend) : begin(bbegin), end(bend) { }
+    pt_reader(pointer bbegin, pointer bend, bool is_compact)
+    : begin(bbegin), end(bend), compact(is_compact) { }
+
+    template<typename T>
+    inline void operator()(T& value,
+                           typename enable_if<is_integral<T>::value>::type* = 0) {
+        begin = read_int(begin, end, compact, value);
+    }
 
     template<typename T>
-    inline void operator()(T& value) {
+    inline void operator()(T& value,
+                           typename enable_if<is_floating_point<T>::value>::type* = 0) {
         begin = read_range(begin, end, value);
     }
 
+    // the IEEE-754 conversion does not work for long double
+    // => fall back to string serialization (event though it sucks)
+    inline void operator()(long double& value) {
+        std::string tmp;
+        begin = read_string(begin, end, compact, tmp);
+        std::istringstream iss{std::move(tmp)};
+        iss >> value;
+    }
+
+    // atoms are always written as fixed-size integer
+    inline void operator()(atom_value& value) {
+        uint64_t tmp;
+        begin = read_range(begin, end, tmp);
+        value = static_cast<atom_value>(tmp);
+    }
+
+    inline void operator()(string& value) {
+        begin = read_string(begin, end, compact, value);
+    }
+
+    // char16_t is guaranteed to has *at least* 16 bytes,
+    // but not to have *exactly* 16 bytes; thus use uint16_t
+    inline void operator()(u16string& value) {
+        begin = read_unicode_string<uint16_t>(begin, end, compact, value);
+    }
+
+    // char32_t is guaranteed to has *at least* 32 bytes,
+    // but not to have *exactly* 32 bytes; thus use uint32_t
+    inline void operator()(u32string& value) {
+        begin = read_unicode_string<uint32_t>(begin, end, compact, value);
+    }
+
 };
 
 } // namespace <anonmyous>
 
 binary_deserializer::binary_deserializer(const void* buf, size_t buf_size,
                                          actor_namespace* ns,
-                                         type_lookup_table* tbl)
-: super(ns, tbl), m_pos(buf), m_end(advanced(buf, buf_size)) { }
+                                         type_lookup_table* tbl,
+                                         address_lookup_table* addrs)
+: super(ns, tbl, addrs), m_pos(buf), m_end(advanced(buf, buf_size))
+, m_compact(false) { }
 
 binary_deserializer::binary_deserializer(const void* bbegin, const void* bend,
                                          actor_namespace* ns,
-                                         type_lookup_table* tbl)
-: super(ns, tbl), m_pos(bbegin), m_end(bend) { }
+                                         type_lookup_table* tbl,
+                                         address_lookup_table* addrs)
+: super(ns, tbl, addrs), m_pos(bbegin), m_end(bend), m_compact(false) { }
 
 const uniform_type_info* binary_deserializer::begin_object() {
+    // the compact format uses type ID 0 instead of a flag
+    // to indicate that the type name follows
     std::uint8_t flag;
-    m_pos = read_range(m_pos, m_end, flag);
+    std::uint32_t type_id = 0;
+    if (m_compact) {
+        m_pos = read_int(m_pos, m_end, true, type_id);
+        flag = (type_id == 0) ? 1 : 0;
+    }
+    else m_pos = read_range(m_pos, m_end, flag);
     if (flag == 1) {
         string tname;
-        m_pos = read_range(m_pos, m_end, tname);
+        m_pos = read_string(m_pos, m_end, m_compact, tname);
         auto uti = get_uniform_type_info_map()->by_uniform_name(tname);
         if (!uti) {
             std::string err = "received type name \"";
@@ -171,8 +271,7 @@ const uniform_type_info* binary_deserializer::begin_object() {
         return uti;
     }
     else {
-        std::uint32_t type_id;
-        m_pos = read_range(m_pos, m_end, type_id);
+        if (!m_compact) m_pos = read_range(m_pos, m_end, type_id);
         auto it = incoming_types();
         if (!it) {
             std::string err = "received type ID ";
@@ -193,7 +292,7 @@ size_t binary_deserializer::begin_sequence() {
     static_assert(sizeof(size_t) >= sizeof(uint32_t),
                   "sizeof(size_t) < sizeof(uint32_t)");
     uint32_t result;
-    m_pos = read_range(m_pos, m_end, result);
+    m_pos = read_int(m_pos, m_end, m_compact, result);
     return static_cast<size_t>(result);
 }
 
@@ -201,7 +300,7 @@ void binary_deserializer::end_sequence() { }
 
 primitive_variant binary_deserializer::read_value(primitive_type ptype) {
     primitive_variant val(ptype);
-    pt_reader ptr(m_pos, m_end);
+    pt_reader ptr(m_pos, m_end, m_compact);
     val.apply(ptr);
     m_pos = ptr.begin;
     return val;
@@ -222,4 +321,54 @@ void binary_deserializer::read_raw(size_t num_bytes, void* storage) {
     m_pos = advanced(m_pos, num_bytes);
 }
 
+bool binary_deserializer::native_layout() const {
+    return !m_compact;
+}
+
+util::byte_slice binary_deserializer::read_slice(size_t num_bytes) {
+    range_check(m_pos, m_end, num_bytes);
+    if (!m_storage) return super::read_slice(num_bytes);
+    auto data = m_pos;
+    m_pos = advanced(m_pos, num_bytes);
+    return {m_storage, data, num_bytes};
+}
+
+void binary_deserializer::read_values(primitive_type ptype, size_t num,
+                                      void* storage) {
+    auto c = m_compact;
+    switch (ptype) {
+        case pt_int8:
+            m_pos = read_ints<int8_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_int16:
+            m_pos = read_ints<int16_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_int32:
+            m_pos = read_ints<int32_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_int64:
+            m_pos = read_ints<int64_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_uint8:
+            m_pos = read_ints<uint8_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_uint16:
+            m_pos = read_ints<uint16_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_uint32:
+            m_pos = read_ints<uint32_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_uint64:
+            m_pos = read_ints<uint64_t>(m_pos, m_end, c, num, storage);
+            break;
+        case pt_float:
+            m_pos = read_packed(m_pos, m_end, num, static_cast<float*>(storage));
+            break;
+        case pt_double:
+            m_pos = read_packed(m_pos, m_end, num, static_cast<double*>(storage));
+            break;
+        default: super::read_values(ptype, num, storage);
+    }
+}
+
 } // namespace cppa
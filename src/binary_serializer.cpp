@@ -18,6 +18,7 @@
 
 
 #include <limits>
+#include <algorithm>
 #include <string>
 #include <iomanip>
 #include <cstdint>
@@ -44,23 +45,62 @@ class binary_writer {
 
  public:
 
-    binary_writer(util::buffer* sink) : m_sink(sink) { }
+    binary_writer(util::buffer* sink, bool compact)
+    : m_sink(sink), m_compact(compact) { }
 
     template<typename T>
     static inline void write_int(util::buffer* sink, const T& value) {
         sink->write(sizeof(T), &value, grow_if_needed);
     }
 
-    static inline void write_string(util::buffer* sink,
-                                    const std::string& str) {
-        write_int(sink, static_cast<std::uint32_t>(str.size()));
-        sink->write(str.size(), str.c_str(), grow_if_needed);
+    // LEB128 encoding, i.e., 7 bits per byte with the
+    // most significant bit set on all but the last byte
+    static inline void write_varint(util::buffer* sink, std::uint64_t value) {
+        std::uint8_t bytes[10];
+        size_t num = 0;
+        while (value >= 0x80) {
+            bytes[num++] = static_cast<std::uint8_t>(value | 0x80);
+            value >>= 7;
+        }
+        bytes[num++] = static_cast<std::uint8_t>(value);
+        sink->write(num, bytes, grow_if_needed);
+    }
+
+    // maps signed integers to unsigned integers with small
+    // absolute values mapped to small values (zigzag encoding)
+    template<typename T>
+    static inline std::uint64_t zigzag(T value,
+                typename enable_if<std::is_signed<T>::value>::type* = 0) {
+        auto x = static_cast<std::int64_t>(value);
+        return (static_cast<std::uint64_t>(x) << 1)
+               ^ static_cast<std::uint64_t>(x >> 63);
+    }
+
+    template<typename T>
+    static inline std::uint64_t zigzag(T value,
+                typename enable_if<!std::is_signed<T>::value>::type* = 0) {
+        return static_cast<std::uint64_t>(value);
+    }
+
+    template<typename T>
+    void write_integer(const T& value) {
+        if (m_compact && sizeof(T) > 1) write_varint(m_sink, zigzag(value));
+        else write_int(m_sink, value);
+    }
+
+    void write_length(size_t value) {
+        write_integer(static_cast<std::uint32_t>(value));
+    }
+
+    void write_string(const std::string& str) {
+        write_length(str.size());
+        m_sink->write(str.size(), str.c_str(), grow_if_needed);
     }
 
     template<typename T>
     void operator()(const T& value,
                     typename enable_if<std::is_integral<T>::value>::type* = 0) {
-        write_int(m_sink, value);
+        write_integer(value);
     }
 
     template<typename T>
@@ -75,36 +115,69 @@ class binary_writer {
     void operator()(const long double& v) {
         std::ostringstream oss;
         oss << std::setprecision(std::numeric_limits<long double>::digits) << v;
-        write_string(m_sink, oss.str());
+        write_string(oss.str());
     }
 
+    // atoms use all bits, i.e., a varint would only add overhead
     void operator()(const atom_value& val) {
-        (*this)(static_cast<uint64_t>(val));
+        write_int(m_sink, static_cast<uint64_t>(val));
     }
 
     void operator()(const std::string& str) {
-        write_string(m_sink, str);
+        write_string(str);
     }
 
+    // force writer to use exactly 16 bit per character
     void operator()(const std::u16string& str) {
-        write_int(m_sink, static_cast<std::uint32_t>(str.size()));
-        for (char16_t c : str) {
-            // force writer to use exactly 16 bit
-            write_int(m_sink, static_cast<std::uint16_t>(c));
-        }
+        write_unicode_string<std::uint16_t>(str);
     }
 
+    // force writer to use exactly 32 bit per character
     void operator()(const std::u32string& str) {
-        write_int(m_sink, static_cast<std::uint32_t>(str.size()));
-        for (char32_t c : str) {
-            // force writer to use exactly 32 bit
-            write_int(m_sink, static_cast<std::uint32_t>(c));
+        write_unicode_string<std::uint32_t>(str);
+    }
+
+    template<typename T>
+    void write_packed(size_t num, const T* values) {
+        // pack in blocks to keep the number of buffer writes low
+        typename detail::ieee_754_trait<T>::packed_type block[256];
+        while (num > 0) {
+            auto n = std::min(num, sizeof(block) / sizeof(block[0]));
+            for (size_t i = 0; i < n; ++i) block[i] = detail::pack754(values[i]);
+            m_sink->write(n * sizeof(block[0]), block, grow_if_needed);
+            values += n;
+            num -= n;
+        }
+    }
+
+    template<typename T>
+    void write_integers(size_t num, const void* values) {
+        auto first = static_cast<const T*>(values);
+        if (!m_compact || sizeof(T) == 1) {
+            // the sequence has the wire format already
+            m_sink->write(num * sizeof(T), first, grow_if_needed);
+        }
+        else {
+            for (auto i = first; i != first + num; ++i) {
+                write_varint(m_sink, zigzag(*i));
+            }
         }
     }
 
  private:
 
+    template<typename CharType, typename StringType>
+    void write_unicode_string(const StringType& str) {
+        write_length(str.size());
+        if (sizeof(typename StringType::value_type) == sizeof(CharType)) {
+            m_sink->write(str.size() * sizeof(CharType), str.data(),
+                          grow_if_needed);
+        }
+        else for (auto c : str) write_int(m_sink, static_cast<CharType>(c));
+    }
+
     util::buffer* m_sink;
+    bool m_compact;
 
 };
 
@@ -112,35 +185,69 @@ class binary_writer {
 
 binary_serializer::binary_serializer(util::buffer* buf,
                                      actor_namespace* ns,
-                                     type_lookup_table* tbl)
-: super(ns, tbl), m_sink(buf) { }
+                                     type_lookup_table* tbl,
+                                     address_lookup_table* addrs)
+: super(ns, tbl, addrs), m_sink(buf), m_compact(false) { }
 
 void binary_serializer::begin_object(const uniform_type_info* uti) {
     CPPA_REQUIRE(uti != nullptr);
     auto ot = outgoing_types();
     std::uint32_t id = (ot) ? ot->id_of(uti) : 0;
+    binary_writer writer(m_sink, m_compact);
+    if (m_compact) {
+        // a single varint, 0 indicates that the type name follows
+        writer.write_integer(id);
+        if (id == 0) writer.write_string(uti->name());
+        return;
+    }
     std::uint8_t flag = (id == 0) ? 1 : 0;
     binary_writer::write_int(m_sink, flag);
-    if (flag == 1) binary_writer::write_string(m_sink, uti->name());
+    if (flag == 1) writer.write_string(uti->name());
     else binary_writer::write_int(m_sink, id);
 }
 
 void binary_serializer::end_object() { }
 
 void binary_serializer::begin_sequence(size_t list_size) {
-    binary_writer::write_int(m_sink, static_cast<std::uint32_t>(list_size));
+    binary_writer(m_sink, m_compact).write_length(list_size);
 }
 
 void binary_serializer::end_sequence() { }
 
 void binary_serializer::write_value(const primitive_variant& value) {
-    value.apply(binary_writer(m_sink));
+    value.apply(binary_writer(m_sink, m_compact));
 }
 
 void binary_serializer::write_raw(size_t num_bytes, const void* data) {
     m_sink->write(num_bytes, data, grow_if_needed);
 }
 
+void binary_serializer::write_values(primitive_type ptype, size_t num,
+                                     const void* values) {
+    binary_writer writer(m_sink, m_compact);
+    switch (ptype) {
+        case pt_int8:   writer.write_integers<std::int8_t>(num, values);   break;
+        case pt_int16:  writer.write_integers<std::int16_t>(num, values);  break;
+        case pt_int32:  writer.write_integers<std::int32_t>(num, values);  break;
+        case pt_int64:  writer.write_integers<std::int64_t>(num, values);  break;
+        case pt_uint8:  writer.write_integers<std::uint8_t>(num, values);  break;
+        case pt_uint16: writer.write_integers<std::uint16_t>(num, values); break;
+        case pt_uint32: writer.write_integers<std::uint32_t>(num, values); break;
+        case pt_uint64: writer.write_integers<std::uint64_t>(num, values); break;
+        case pt_float:
+            writer.write_packed(num, static_cast<const float*>(values));
+            break;
+        case pt_double:
+            writer.write_packed(num, static_cast<const double*>(values));
+            break;
+        default: super::write_values(ptype, num, values);
+    }
+}
+
+bool binary_serializer::native_layout() const {
+    return !m_compact;
+}
+
 void binary_serializer::write_tuple(size_t size,
                                     const primitive_variant* values) {
     const primitive_variant* end = values + size;
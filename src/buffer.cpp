@@ -83,20 +83,15 @@ void buffer::final_size(size_t new_value) {
         throw std::invalid_argument("new_value > maximum_size()");
     }
     m_final_size = new_value;
-
-
     if (new_value > m_allocated) {
         auto remainder = (new_value % m_chunk_size);
         if (remainder == 0) m_allocated = new_value;
         else m_allocated = (new_value - remainder) + m_chunk_size;
-
-        if (remainder == 0) m_allocated = new_value;
-        else m_allocated = (new_value - remainder) + m_chunk_size;
-
-
-
-        delete[] m_data;
+        // keep data that was already written to the buffer
+        auto old_data = m_data;
         m_data = new char[m_allocated];
+        if (m_written > 0) memcpy(m_data, old_data, m_written);
+        delete[] old_data;
     }
 }
 
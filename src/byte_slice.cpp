@@ -0,0 +1,56 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <cstring>
+#include <algorithm>
+
+#include "cppa/util/byte_slice.hpp"
+
+namespace cppa {
+namespace util {
+
+byte_slice::byte_slice() : m_data(nullptr), m_size(0) { }
+
+byte_slice::byte_slice(const void* data, size_t num_bytes)
+: m_data(nullptr), m_size(0) {
+    if (num_bytes > 0) {
+        buffer tmp{num_bytes, num_bytes};
+        tmp.write(num_bytes, data);
+        m_storage.reset(new shared_buffer(std::move(tmp)));
+        m_data = reinterpret_cast<const char*>(m_storage->get().data());
+        m_size = num_bytes;
+    }
+}
+
+byte_slice::byte_slice(const std::string& str)
+: byte_slice(str.data(), str.size()) { }
+
+byte_slice::byte_slice(shared_buffer_ptr storage,
+                       const void* data, size_t num_bytes)
+: m_storage(std::move(storage)), m_data(reinterpret_cast<const char*>(data))
+, m_size(num_bytes) { }
+
+int byte_slice::compare(const byte_slice& other) const {
+    auto res = memcmp(m_data, other.m_data, std::min(m_size, other.m_size));
+    if (res != 0 || m_size == other.m_size) return res;
+    return m_size < other.m_size ? -1 : 1;
+}
+
+} // namespace util
+} // namespace cppa
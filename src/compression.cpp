@@ -0,0 +1,197 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+
+#include "cppa/util/compression.hpp"
+
+namespace cppa {
+namespace util {
+
+namespace {
+
+// each sequence starts with a token; the high nibble stores the number of
+// literals, the low nibble the match length minus min_match, and a nibble
+// value of 15 is followed by extra length bytes until a byte below 255
+
+constexpr size_t min_match = 4;
+
+constexpr size_t max_offset = 0xFFFF;
+
+constexpr std::uint8_t nibble_max = 15;
+
+// number of bits used to index previously seen four-byte sequences
+constexpr int hash_bits = 12;
+
+inline std::uint32_t read32(const std::uint8_t* ptr) {
+    std::uint32_t result;
+    memcpy(&result, ptr, sizeof(std::uint32_t));
+    return result;
+}
+
+inline size_t hash_of(std::uint32_t x) {
+    return (x * 2654435761U) >> (32 - hash_bits);
+}
+
+void write_length(buffer& storage, size_t len) {
+    std::uint8_t tmp[64];
+    size_t n = 0;
+    for (; len >= 255; len -= 255) {
+        tmp[n++] = 255;
+        if (n == sizeof(tmp)) {
+            storage.write(n, tmp);
+            n = 0;
+        }
+    }
+    tmp[n++] = static_cast<std::uint8_t>(len);
+    storage.write(n, tmp);
+}
+
+bool read_length(const std::uint8_t*& first, const std::uint8_t* last,
+                 size_t& len) {
+    if (len < nibble_max) return true;
+    std::uint8_t x;
+    do {
+        if (first == last) return false;
+        x = *first++;
+        len += x;
+    }
+    while (x == 255);
+    return true;
+}
+
+// writes a sequence of literals followed by a match of length
+// @p match_len at @p offset or no match if @p match_len is 0
+void write_sequence(buffer& storage, const std::uint8_t* literals,
+                    size_t literals_len, size_t match_len, size_t offset) {
+    auto ml = match_len > 0 ? match_len - min_match : 0;
+    auto token = static_cast<std::uint8_t>(
+                     (std::min<size_t>(literals_len, nibble_max) << 4)
+                   | std::min<size_t>(ml, nibble_max));
+    storage.write(1, &token);
+    if (literals_len >= nibble_max) {
+        write_length(storage, literals_len - nibble_max);
+    }
+    storage.write(literals_len, literals);
+    if (match_len > 0) {
+        auto off = static_cast<std::uint16_t>(offset);
+        storage.write(sizeof(std::uint16_t), &off);
+        if (ml >= nibble_max) write_length(storage, ml - nibble_max);
+    }
+}
+
+} // namespace <anonymous>
+
+size_t compress(const void* data, size_t size, buffer& storage) {
+    auto before = storage.size();
+    auto orig_size = static_cast<std::uint32_t>(size);
+    storage.write(sizeof(std::uint32_t), &orig_size);
+    auto first = static_cast<const std::uint8_t*>(data);
+    auto last = first + size;
+    // positions of four-byte sequences, relative to first
+    std::uint32_t table[1 << hash_bits];
+    std::fill(std::begin(table), std::end(table), 0);
+    auto anchor = first;
+    auto pos = first;
+    // the first byte never is a match, i.e., a table entry of 0 is unused
+    if (size >= min_match) ++pos;
+    while (size >= min_match && pos + min_match <= last) {
+        auto h = hash_of(read32(pos));
+        auto candidate = first + table[h];
+        table[h] = static_cast<std::uint32_t>(pos - first);
+        if (   candidate == first
+            || static_cast<size_t>(pos - candidate) > max_offset
+            || read32(candidate) != read32(pos)) {
+            // probe less often the longer no match was found,
+            // which speeds up compressing incompressible data
+            pos += 1 + ((pos - anchor) >> 6);
+            continue;
+        }
+        auto match_end = pos + min_match;
+        auto ref = candidate + min_match;
+        while (match_end < last && *match_end == *ref) {
+            ++match_end;
+            ++ref;
+        }
+        write_sequence(storage, anchor, static_cast<size_t>(pos - anchor),
+                       static_cast<size_t>(match_end - pos),
+                       static_cast<size_t>(pos - candidate));
+        pos = match_end;
+        anchor = pos;
+    }
+    write_sequence(storage, anchor, static_cast<size_t>(last - anchor), 0, 0);
+    return storage.size() - before;
+}
+
+bool decompress(const void* data, size_t size, buffer& storage,
+                size_t max_size) {
+    if (size < sizeof(std::uint32_t)) return false;
+    std::uint32_t orig_size;
+    memcpy(&orig_size, data, sizeof(std::uint32_t));
+    if (orig_size > max_size) return false;
+    auto first = static_cast<const std::uint8_t*>(data)
+                 + sizeof(std::uint32_t);
+    auto last = static_cast<const std::uint8_t*>(data) + size;
+    auto begin = storage.size();
+    auto end = begin + orig_size;
+    // allocate everything upfront; back references point into
+    // the buffer itself and must not get invalidated by writes
+    storage.acquire(orig_size);
+    while (first != last) {
+        auto token = *first++;
+        size_t literals_len = token >> 4;
+        if (   !read_length(first, last, literals_len)
+            || static_cast<size_t>(last - first) < literals_len
+            || end - storage.size() < literals_len) {
+            return false;
+        }
+        storage.write(literals_len, first);
+        first += literals_len;
+        // the last sequence consists of literals only
+        if (storage.size() == end) return first == last;
+        if (static_cast<size_t>(last - first) < sizeof(std::uint16_t)) {
+            return false;
+        }
+        std::uint16_t offset;
+        memcpy(&offset, first, sizeof(std::uint16_t));
+        first += sizeof(std::uint16_t);
+        size_t match_len = token & nibble_max;
+        if (!read_length(first, last, match_len)) return false;
+        match_len += min_match;
+        if (   offset == 0
+            || offset > storage.size() - begin
+            || end - storage.size() < match_len) {
+            return false;
+        }
+        // copy in steps of at most offset bytes to handle matches
+        // overlapping with their own output
+        while (match_len > 0) {
+            auto n = std::min<size_t>(match_len, offset);
+            storage.write(n, storage.offset_data(storage.size() - offset));
+            match_len -= n;
+        }
+    }
+    return false;
+}
+
+} // namespace util
+} // namespace cppa
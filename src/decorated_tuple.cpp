@@ -66,29 +66,42 @@ void decorated_tuple::init(size_t offset) {
 }
 
 decorated_tuple::decorated_tuple(pointer d, vector_type&& v)
-: super(true), m_decorated(std::move(d)), m_token(&typeid(void)), m_mapping(std::move(v)) {
+: super(true), m_decorated(std::move(d)), m_token(&typeid(void)), m_mapping(std::move(v))
+, m_type_names(nullptr) {
     init();
 }
 
 decorated_tuple::decorated_tuple(pointer d, rtti ti, vector_type&& v)
-: super(false), m_decorated(std::move(d)), m_token(ti), m_mapping(std::move(v)) {
+: super(false), m_decorated(std::move(d)), m_token(ti), m_mapping(std::move(v))
+, m_type_names(nullptr) {
     init();
 }
 
 decorated_tuple::decorated_tuple(pointer d, size_t offset)
-: super(true), m_decorated(std::move(d)), m_token(&typeid(void)) {
+: super(true), m_decorated(std::move(d)), m_token(&typeid(void))
+, m_type_names(nullptr) {
     init(offset);
 }
 
 decorated_tuple::decorated_tuple(pointer d, rtti ti, size_t offset)
-: super(false), m_decorated(std::move(d)), m_token(ti) {
+: super(false), m_decorated(std::move(d)), m_token(ti)
+, m_type_names(nullptr) {
     init(offset);
 }
 
+decorated_tuple::decorated_tuple(const decorated_tuple& other)
+: super(other), m_decorated(other.m_decorated), m_token(other.m_token)
+, m_mapping(other.m_mapping), m_type_names(other.m_type_names.load()) { }
+
 const std::string* decorated_tuple::tuple_type_names() const {
-    // produced name is equal for all instances
-    static std::string result = get_tuple_type_names(*this);
-    return &result;
+    // the names depend on the decorated tuple, i.e., may differ
+    // between instances; concurrent readers store the same value
+    auto result = m_type_names.load(std::memory_order_relaxed);
+    if (!result) {
+        result = interned_tuple_type_names(*this);
+        m_type_names.store(result, std::memory_order_relaxed);
+    }
+    return result;
 }
 
 } // namespace detail
@@ -71,14 +71,14 @@ std::string demangle(const char* decorated) {
             c = *++cstr;
         }
     }
-#   ifdef CPPA_CLANG
-    // replace "std::__1::" with "std::" (fixes strange clang names)
-    std::string needle = "std::__1::";
+    // replace "std::__1::" (libc++) and "std::__cxx11::" (libstdc++)
+    // with "std::" to get the same names for all standard libraries
     std::string fixed_string = "std::";
-    for (auto pos = result.find(needle); pos != std::string::npos; pos = result.find(needle)) {
-        result.replace(pos, needle.size(), fixed_string);
+    for (std::string needle : {"std::__1::", "std::__cxx11::"}) {
+        for (auto pos = result.find(needle); pos != std::string::npos; pos = result.find(needle)) {
+            result.replace(pos, needle.size(), fixed_string);
+        }
     }
-#   endif
     return result;
 }
 
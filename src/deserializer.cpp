@@ -18,26 +18,72 @@
 
 
 #include <string>
+#include <cstdint>
+#include <stdexcept>
 
 #include "cppa/object.hpp"
 #include "cppa/deserializer.hpp"
 #include "cppa/uniform_type_info.hpp"
 
 #include "cppa/util/buffer.hpp"
+#include "cppa/util/byte_slice.hpp"
 
 #include "cppa/detail/to_uniform_name.hpp"
 
 namespace cppa {
 
-deserializer::deserializer(actor_namespace* ns, type_lookup_table* ot)
-: m_namespace{ns}, m_incoming_types{ot} { }
+namespace {
+
+template<typename T>
+void read_each(deserializer* source, size_t num, void* storage) {
+    auto first = static_cast<T*>(storage);
+    for (auto i = first; i != first + num; ++i) {
+        *i = source->read<T>();
+    }
+}
+
+} // namespace <anonymous>
+
+deserializer::deserializer(actor_namespace* ns, type_lookup_table* ot,
+                           address_lookup_table* at)
+: m_namespace{ns}, m_incoming_types{ot}, m_incoming_addresses{at} { }
 
 deserializer::~deserializer() { }
 
+bool deserializer::native_layout() const {
+    return false;
+}
+
+void deserializer::read_values(primitive_type ptype, size_t num,
+                               void* storage) {
+    switch (ptype) {
+        case pt_int8:   read_each<std::int8_t>(this, num, storage);   break;
+        case pt_int16:  read_each<std::int16_t>(this, num, storage);  break;
+        case pt_int32:  read_each<std::int32_t>(this, num, storage);  break;
+        case pt_int64:  read_each<std::int64_t>(this, num, storage);  break;
+        case pt_uint8:  read_each<std::uint8_t>(this, num, storage);  break;
+        case pt_uint16: read_each<std::uint16_t>(this, num, storage); break;
+        case pt_uint32: read_each<std::uint32_t>(this, num, storage); break;
+        case pt_uint64: read_each<std::uint64_t>(this, num, storage); break;
+        case pt_float:  read_each<float>(this, num, storage);          break;
+        case pt_double: read_each<double>(this, num, storage);        break;
+        default: throw std::invalid_argument("read_values: "
+                                             "not an arithmetic type");
+    }
+}
+
 void deserializer::read_raw(size_t num_bytes, util::buffer& storage) {
     storage.acquire(num_bytes);
     read_raw(num_bytes, storage.data());
     storage.inc_size(num_bytes);
 }
 
+util::byte_slice deserializer::read_slice(size_t num_bytes) {
+    if (num_bytes == 0) return {};
+    util::shared_buffer_ptr storage{new util::shared_buffer};
+    read_raw(num_bytes, storage->get());
+    auto data = storage->get().data();
+    return {std::move(storage), data, num_bytes};
+}
+
 } // namespace cppa
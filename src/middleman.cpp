@@ -26,6 +26,7 @@
 #include <stdexcept>
 
 #include "cppa/on.hpp"
+#include "cppa/cppa.hpp"
 #include "cppa/actor.hpp"
 #include "cppa/match.hpp"
 #include "cppa/config.hpp"
@@ -33,6 +34,7 @@
 #include "cppa/node_id.hpp"
 #include "cppa/to_string.hpp"
 #include "cppa/actor_proxy.hpp"
+#include "cppa/system_messages.hpp"
 #include "cppa/binary_serializer.hpp"
 #include "cppa/uniform_type_info.hpp"
 #include "cppa/binary_deserializer.hpp"
@@ -45,6 +47,7 @@
 
 #include "cppa/io/peer.hpp"
 #include "cppa/io/acceptor.hpp"
+#include "cppa/io/resolver.hpp"
 #include "cppa/io/middleman.hpp"
 #include "cppa/io/input_stream.hpp"
 #include "cppa/io/output_stream.hpp"
@@ -54,6 +57,7 @@
 #include "cppa/io/middleman_event_handler.hpp"
 
 #include "cppa/detail/fd_util.hpp"
+#include "cppa/detail/raw_access.hpp"
 #include "cppa/detail/actor_registry.hpp"
 
 #include "cppa/intrusive/single_reader_queue.hpp"
@@ -127,9 +131,16 @@ void middleman::continue_writer(continuable* ptr) {
 
 void middleman::stop_writer(continuable* ptr) {
     CPPA_LOG_TRACE(CPPA_ARG(ptr));
+    m_connecting.erase(ptr);
     m_handler->erase_later(ptr, event::write);
 }
 
+void middleman::continue_connecting(continuable* ptr) {
+    CPPA_LOG_TRACE(CPPA_ARG(ptr));
+    m_connecting.insert(ptr);
+    m_handler->add_later(ptr, event::write);
+}
+
 bool middleman::has_writer(continuable* ptr) {
     return m_handler->has_writer(ptr);
 }
@@ -170,6 +181,11 @@ class middleman_impl : public middleman {
         notify_queue_event(m_pipe_in);
     }
 
+    void run_delayed(chrono::milliseconds rel_time,
+                     function<void()> fun) override {
+        m_delayed.emplace(chrono::steady_clock::now() + rel_time, move(fun));
+    }
+
     bool register_peer(const node_id& node, peer* ptr) override {
         CPPA_LOG_TRACE("node = " << to_string(node) << ", ptr = " << ptr);
         auto& entry = m_peers[node];
@@ -177,10 +193,7 @@ class middleman_impl : public middleman {
             if (entry.queue == nullptr) entry.queue.emplace();
             ptr->set_queue(entry.queue);
             entry.impl = ptr;
-            if (!entry.queue->empty()) {
-                auto tmp = entry.queue->pop();
-                ptr->enqueue(tmp.first, tmp.second);
-            }
+            ptr->flush_queue();
             CPPA_LOG_INFO("peer " << to_string(node) << " added");
             return true;
         }
@@ -222,15 +235,21 @@ class middleman_impl : public middleman {
                  msg_hdr_cref hdr,
                  any_tuple msg                  ) override {
         auto& entry = m_peers[node];
+        if (entry.queue == nullptr) entry.queue.emplace();
+        if (congested(entry) && droppable(hdr, msg)) {
+            bounce_congested(hdr);
+            return;
+        }
         if (entry.impl) {
-            CPPA_REQUIRE(entry.queue != nullptr);
-            if (!entry.impl->has_unwritten_data()) {
-                CPPA_REQUIRE(entry.queue->empty());
+            // serialize message directly into the write buffer of the
+            // peer unless older messages are still waiting in its queue,
+            // this allows us to keep track of buffered data in bytes;
+            // high-priority messages overtake queued messages
+            if (entry.queue->empty() || hdr.id.is_high_priority()) {
                 entry.impl->enqueue(hdr, msg);
                 return;
             }
         }
-        if (entry.queue == nullptr) entry.queue.emplace();
         entry.queue->emplace(hdr, msg);
     }
 
@@ -244,13 +263,24 @@ class middleman_impl : public middleman {
         }
     }
 
-    void new_peer(const input_stream_ptr& in,
-                  const output_stream_ptr& out,
-                  const node_id_ptr& node = nullptr) override {
+    peer* new_peer(const input_stream_ptr& in,
+                   const output_stream_ptr& out,
+                   const node_id_ptr& node = nullptr) override {
         CPPA_LOG_TRACE("");
         auto ptr = new peer(this, in, out, node);
         continue_reader(ptr);
         if (node) register_peer(*node, ptr);
+        return ptr;
+    }
+
+    void new_client_peer(const input_stream_ptr& in,
+                         const output_stream_ptr& out,
+                         std::set<std::string> expected_iface,
+                         handshake_handler hdl) override {
+        CPPA_LOG_TRACE("");
+        auto ptr = new peer(this, in, out);
+        ptr->start_handshake(std::move(expected_iface), std::move(hdl));
+        continue_reader(ptr);
     }
 
     void del_peer(peer* pptr) override {
@@ -287,6 +317,7 @@ class middleman_impl : public middleman {
 #       endif
         m_node = compute_node_id();
         m_handler = middleman_event_handler::create();
+        m_resolver.reset(new resolver(this));
         m_namespace.set_proxy_factory([=](actor_id aid, node_id_ptr ptr) {
             return make_counted<remote_actor_proxy>(aid, std::move(ptr), this);
         });
@@ -308,6 +339,9 @@ class middleman_impl : public middleman {
 
     void destroy() override {
         CPPA_LOG_TRACE("");
+        // the resolver passes results to the event loop, i.e.,
+        // it must be stopped before the event loop
+        m_resolver->stop();
         run_later([this] {
             CPPA_LOGM_TRACE("destroy$helper", "");
             this->m_done = true;
@@ -332,10 +366,56 @@ class middleman_impl : public middleman {
         return new cppa::node_id(static_cast<uint32_t>(getpid()), node_id);
     }
 
+    // only user messages from local actors are dropped on congestion,
+    // responses, exit messages and messages of the runtime system pass
+    static bool droppable(msg_hdr_cref hdr, const any_tuple& msg) {
+        if (!hdr.sender || hdr.sender.is_remote() || hdr.id.is_response()) {
+            return false;
+        }
+        return !(msg.size() == 1 && msg.type_at(0) == uniform_typeid<exit_msg>());
+    }
+
+    static void bounce_congested(msg_hdr_cref hdr) {
+        auto rawptr = detail::raw_access::get(hdr.receiver);
+        auto dest = dynamic_cast<abstract_actor*>(rawptr);
+        actor_addr source = dest ? dest->address() : invalid_actor_addr;
+        CPPA_LOGF_INFO("drop message to " << to_string(source)
+                       << ", because connection is congested");
+        auto sender = detail::raw_access::get(hdr.sender);
+        auto mid = hdr.id.is_request() ? hdr.id.response_id()
+                                       : message_id::invalid;
+        sender->enqueue({source, sender, mid},
+                        make_any_tuple(peer_congested_msg{source}),
+                        nullptr);
+    }
+
     inline void quit() { m_done = true; }
 
     inline bool done() const { return m_done; }
 
+    // returns the time until the next functor passed to run_delayed()
+    // is due in milliseconds or -1 if there is no such functor
+    int poll_timeout() const {
+        if (m_delayed.empty()) return -1;
+        auto now = chrono::steady_clock::now();
+        auto due = m_delayed.begin()->first;
+        if (due <= now) return 0;
+        auto rel = chrono::duration_cast<chrono::milliseconds>(due - now);
+        // round up to not wake up before the functor is due
+        if (rel < due - now) rel += chrono::milliseconds(1);
+        return static_cast<int>(rel.count());
+    }
+
+    // runs all functors passed to run_delayed() that are due
+    void run_due_functors() {
+        auto now = chrono::steady_clock::now();
+        while (!m_delayed.empty() && m_delayed.begin()->first <= now) {
+            auto fun = move(m_delayed.begin()->second);
+            m_delayed.erase(m_delayed.begin());
+            fun();
+        }
+    }
+
     bool m_done;
 
     middleman_event_handler& handler();
@@ -344,12 +424,29 @@ class middleman_impl : public middleman {
     native_socket_type m_pipe_out;
     native_socket_type m_pipe_in;
     middleman_queue m_queue;
+    multimap<chrono::steady_clock::time_point, function<void()>> m_delayed;
 
     struct peer_entry {
         peer* impl;
         default_message_queue_ptr queue;
+        // true if more than peer_buffer_high_watermark() bytes were
+        // buffered and not yet dropped below peer_buffer_low_watermark()
+        bool congested;
     };
 
+    // messages wait in the queue while no peer is registered for a
+    // node, i.e., they are counted even if no connection exists
+    static bool congested(peer_entry& entry) {
+        auto buffered =   entry.queue->size()
+                        * default_message_queue::estimated_message_size;
+        if (entry.impl) buffered += entry.impl->buffered_bytes();
+        if (entry.congested) {
+            entry.congested = buffered >= peer_buffer_low_watermark();
+        }
+        else entry.congested = buffered > peer_buffer_high_watermark();
+        return entry.congested;
+    }
+
     std::map<actor_addr, std::vector<peer_acceptor*>> m_acceptors;
     std::map<node_id, peer_entry> m_peers;
 
@@ -478,9 +575,15 @@ void middleman_loop(middleman_impl* impl) {
                     impl->stop_writer(io);
                 }
             }
-        });
+        }, impl->poll_timeout());
+        impl->run_due_functors();
+        handler->update();
     }
-    CPPA_LOGF_DEBUG("event loop done, erase all readers");
+    CPPA_LOGF_DEBUG("event loop done, drop pending connection attempts");
+    impl->m_delayed.clear();
+    for (auto ptr : impl->m_connecting) handler->erase_later(ptr, event::write);
+    impl->m_connecting.clear();
+    CPPA_LOGF_DEBUG("erase all readers");
     // make sure to write everything before shutting down
     handler->for_each_reader([handler](continuable* ptr) {
         handler->erase_later(ptr, event::read);
@@ -533,6 +636,16 @@ namespace {
 
 std::atomic<size_t> default_max_msg_size{16 * 1024 * 1024};
 
+std::atomic<bool> default_compact_wire_format{false};
+
+std::atomic<bool> default_shm_transport{true};
+
+std::atomic<size_t> default_frame_compression_threshold{0};
+
+std::atomic<size_t> default_peer_low_watermark{32 * 1024 * 1024};
+
+std::atomic<size_t> default_peer_high_watermark{64 * 1024 * 1024};
+
 } // namespace <anonymous>
 
 void max_msg_size(size_t size)
@@ -545,4 +658,53 @@ size_t max_msg_size()
   return default_max_msg_size;
 }
 
+void compact_wire_format(bool enable)
+{
+  default_compact_wire_format = enable;
+}
+
+bool compact_wire_format()
+{
+  return default_compact_wire_format;
+}
+
+void shm_transport(bool enable)
+{
+  default_shm_transport = enable;
+}
+
+bool shm_transport()
+{
+  return default_shm_transport;
+}
+
+void frame_compression_threshold(size_t num_bytes)
+{
+  default_frame_compression_threshold = num_bytes;
+}
+
+size_t frame_compression_threshold()
+{
+  return default_frame_compression_threshold;
+}
+
+void peer_buffer_watermarks(size_t low, size_t high)
+{
+  if (low > high) {
+      throw std::invalid_argument("low > high");
+  }
+  default_peer_low_watermark = low;
+  default_peer_high_watermark = high;
+}
+
+size_t peer_buffer_low_watermark()
+{
+  return default_peer_low_watermark;
+}
+
+size_t peer_buffer_high_watermark()
+{
+  return default_peer_high_watermark;
+}
+
 } // namespace cppa
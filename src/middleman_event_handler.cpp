@@ -17,6 +17,8 @@
 \******************************************************************************/
 
 
+#include <algorithm>
+
 #include "cppa/io/middleman_event_handler.hpp"
 
 namespace cppa {
@@ -134,6 +136,12 @@ void middleman_event_handler::update() {
         auto iter = std::lower_bound(first, last, fd, mless);
         return iter == last || iter->fd != fd;
     };
+    // a continuable with distinct read and write handles is
+    // added once per handle but must be disposed only once
+    std::sort(m_dispose_list.begin(), m_dispose_list.end());
+    m_dispose_list.erase(std::unique(m_dispose_list.begin(),
+                                     m_dispose_list.end()),
+                         m_dispose_list.end());
     // dispose everything that wasn't put back into m_meta again
     for (auto elem : m_dispose_list) {
         CPPA_LOG_DEBUG("dispose " << elem);
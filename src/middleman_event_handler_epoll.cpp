@@ -60,14 +60,14 @@ class middleman_event_handler_impl : public middleman_event_handler {
 
  protected:
 
-    void poll_impl() {
+    void poll_impl(int timeout) {
         CPPA_REQUIRE(m_meta.empty() == false);
         int presult = -1;
         while (presult < 0) {
             presult = epoll_wait(m_epollfd,
                                  m_epollset.data(),
                                  static_cast<int>(m_epollset.size()),
-                                 -1);
+                                 timeout);
             CPPA_LOG_DEBUG("epoll_wait on " << num_sockets()
                            << " sockets returned " << presult);
             if (presult < 0) {
@@ -163,7 +163,12 @@ class middleman_event_handler_impl : public middleman_event_handler {
 
 } // namespace <anonymous>
 
+#ifdef CPPA_IO_URING_IMPL
+// the io_uring backend falls back to epoll if the kernel lacks io_uring
+std::unique_ptr<middleman_event_handler> create_epoll_event_handler() {
+#else
 std::unique_ptr<middleman_event_handler> middleman_event_handler::create() {
+#endif
     return std::unique_ptr<middleman_event_handler>{new middleman_event_handler_impl};
 }
 
@@ -0,0 +1,416 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include "cppa/config.hpp"
+
+#if defined(CPPA_LINUX) && defined(CPPA_IO_URING_IMPL)
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <unordered_map>
+
+#include <poll.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+
+#include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
+#include "cppa/io/middleman_event_handler.hpp"
+
+namespace cppa {
+namespace io {
+
+// implemented in middleman_event_handler_epoll.cpp
+std::unique_ptr<middleman_event_handler> create_epoll_event_handler();
+
+namespace {
+
+static constexpr unsigned input_event  = POLLIN;
+static constexpr unsigned error_event  = POLLRDHUP | POLLERR | POLLHUP;
+static constexpr unsigned output_event = POLLOUT;
+
+// number of submission queue entries, the kernel doubles this
+// value for the completion queue
+static constexpr unsigned ring_entries = 256;
+
+// user data for submissions whose completion is irrelevant
+static constexpr std::uint64_t ignored_completion = 0;
+
+int sys_io_uring_setup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int sys_io_uring_enter(int fd, unsigned to_submit,
+                       unsigned min_complete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+/**
+ * @brief Readiness notification via io_uring. Each registered socket
+ *        has at most one pending one-shot poll request that gets re-armed
+ *        after its completion was dispatched. All re-arms and interest
+ *        changes of one loop iteration are submitted with a single
+ *        io_uring_enter() call that also waits for the next completions.
+ */
+class middleman_event_handler_impl : public middleman_event_handler {
+
+    struct registration {
+        continuable* ptr;
+        event_bitmask mask;
+        std::uint32_t generation;
+        bool armed;
+    };
+
+ public:
+
+    middleman_event_handler_impl()
+    : m_ringfd(-1), m_sq_ring(MAP_FAILED), m_cq_ring(MAP_FAILED)
+    , m_sqes(static_cast<io_uring_sqe*>(MAP_FAILED)), m_sq_ring_size(0)
+    , m_cq_ring_size(0), m_sqes_size(0), m_to_submit(0), m_generation(0) { }
+
+    ~middleman_event_handler_impl() {
+        if (m_sqes != MAP_FAILED) munmap(m_sqes, m_sqes_size);
+        if (m_cq_ring != MAP_FAILED && m_cq_ring != m_sq_ring) {
+            munmap(m_cq_ring, m_cq_ring_size);
+        }
+        if (m_sq_ring != MAP_FAILED) munmap(m_sq_ring, m_sq_ring_size);
+        if (m_ringfd != -1) close(m_ringfd);
+    }
+
+    /**
+     * @brief Creates and maps the rings, returns @p false if the
+     *        running kernel does not provide (a recent enough) io_uring.
+     */
+    bool setup() {
+        io_uring_params params;
+        memset(&params, 0, sizeof(io_uring_params));
+        m_ringfd = sys_io_uring_setup(ring_entries, &params);
+        if (m_ringfd < 0) {
+            m_ringfd = -1;
+            return false;
+        }
+        // we rely on the kernel to never drop completions
+        if ((params.features & IORING_FEAT_NODROP) == 0) return false;
+        m_sq_ring_size = params.sq_off.array
+                       + params.sq_entries * sizeof(std::uint32_t);
+        m_cq_ring_size = params.cq_off.cqes
+                       + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size,
+                                                       m_cq_ring_size);
+        }
+        m_sq_ring = mmap(nullptr, m_sq_ring_size, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, m_ringfd,
+                         IORING_OFF_SQ_RING);
+        if (m_sq_ring == MAP_FAILED) return false;
+        if (single_mmap) m_cq_ring = m_sq_ring;
+        else {
+            m_cq_ring = mmap(nullptr, m_cq_ring_size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, m_ringfd,
+                             IORING_OFF_CQ_RING);
+            if (m_cq_ring == MAP_FAILED) return false;
+        }
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        m_sqes = static_cast<io_uring_sqe*>(mmap(nullptr, m_sqes_size,
+                                                 PROT_READ | PROT_WRITE,
+                                                 MAP_SHARED | MAP_POPULATE,
+                                                 m_ringfd, IORING_OFF_SQES));
+        if (m_sqes == MAP_FAILED) return false;
+        auto sq = static_cast<char*>(m_sq_ring);
+        m_sq_head    = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        m_sq_tail    = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask    = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_array   = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        m_sq_entries = params.sq_entries;
+        auto cq = static_cast<char*>(m_cq_ring);
+        m_cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes    = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void init() {
+        m_events.reserve(64);
+    }
+
+ protected:
+
+    void poll_impl(int timeout) {
+        CPPA_REQUIRE(m_meta.empty() == false);
+        for (auto fd : m_unarmed) {
+            auto i = m_registrations.find(fd);
+            if (i != m_registrations.end() && !i->second.armed) {
+                auto& reg = i->second;
+                auto sqe = next_sqe();
+                sqe->opcode = IORING_OP_POLL_ADD;
+                sqe->fd = fd;
+                sqe->poll32_events = poll_mask(reg.mask);
+                sqe->user_data = to_user_data(fd, reg.generation);
+                commit_sqe();
+                reg.armed = true;
+            }
+        }
+        m_unarmed.clear();
+        if (timeout >= 0 && cq_empty()) {
+            // the timeout completes early once any other request completes
+            m_timeout.tv_sec = timeout / 1000;
+            m_timeout.tv_nsec = (timeout % 1000) * 1000000;
+            auto sqe = next_sqe();
+            sqe->opcode = IORING_OP_TIMEOUT;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<std::uint64_t>(&m_timeout);
+            sqe->len = 1;
+            sqe->off = 1;
+            sqe->user_data = ignored_completion;
+            commit_sqe();
+        }
+        // submit all pending requests and wait for at least one completion
+        // if the completion queue is currently empty
+        bool done = false;
+        while (!done) {
+            auto min_complete = cq_empty() ? 1u : 0u;
+            if (m_to_submit == 0 && min_complete == 0) break;
+            auto presult = sys_io_uring_enter(m_ringfd, m_to_submit,
+                                              min_complete,
+                                              IORING_ENTER_GETEVENTS);
+            CPPA_LOG_DEBUG("io_uring_enter on " << num_sockets()
+                           << " sockets returned " << presult);
+            if (presult >= 0) {
+                m_to_submit -= static_cast<unsigned>(presult);
+                done = m_to_submit == 0 || !cq_empty();
+            }
+            else {
+                switch (errno) {
+                    case EINTR: {
+                        // a signal was caught
+                        // just try again
+                        break;
+                    }
+                    case EAGAIN:
+                    case EBUSY: {
+                        // completion queue is full, consume it first
+                        done = !cq_empty();
+                        break;
+                    }
+                    default: {
+                        perror("io_uring_enter() failed");
+                        CPPA_CRITICAL("io_uring_enter() failed");
+                    }
+                }
+            }
+        }
+        auto head = *m_cq_head;
+        auto tail = __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+        for ( ; head != tail; ++head) {
+            auto& cqe = m_cqes[head & m_cq_mask];
+            dispatch(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(m_cq_head, head, __ATOMIC_RELEASE);
+    }
+
+    void handle_event(fd_meta_event me,
+                      native_socket_type fd,
+                      event_bitmask,
+                      event_bitmask new_bitmask,
+                      continuable* ptr) {
+        switch (me) {
+            case fd_meta_event::add: {
+                auto& reg = m_registrations[fd];
+                reg.ptr = ptr;
+                reg.mask = new_bitmask;
+                reg.generation = next_generation();
+                reg.armed = false;
+                m_unarmed.push_back(fd);
+                break;
+            }
+            case fd_meta_event::mod: {
+                auto i = m_registrations.find(fd);
+                if (i == m_registrations.end()) {
+                    CPPA_LOG_ERROR("cannot modify file descriptor "
+                                   "because it isn't registered");
+                    break;
+                }
+                disarm(fd, i->second);
+                i->second.ptr = ptr;
+                i->second.mask = new_bitmask;
+                m_unarmed.push_back(fd);
+                break;
+            }
+            case fd_meta_event::erase: {
+                auto i = m_registrations.find(fd);
+                if (i == m_registrations.end()) {
+                    CPPA_LOG_ERROR("cannot delete file descriptor "
+                                   "because it isn't registered");
+                    break;
+                }
+                disarm(fd, i->second);
+                m_registrations.erase(i);
+                break;
+            }
+            default: CPPA_CRITICAL("invalid fd_meta_event");
+        }
+    }
+
+ private:
+
+    static unsigned poll_mask(event_bitmask mask) {
+        switch (mask) {
+            case event::read:  return POLLIN | POLLRDHUP;
+            case event::write: return POLLOUT;
+            case event::both:  return POLLIN | POLLRDHUP | POLLOUT;
+            default: CPPA_CRITICAL("invalid event bitmask");
+        }
+    }
+
+    static std::uint64_t to_user_data(int fd, std::uint32_t generation) {
+        return (static_cast<std::uint64_t>(generation) << 32)
+               | static_cast<std::uint32_t>(fd);
+    }
+
+    // generations are never 0 to keep ignored_completion unique
+    std::uint32_t next_generation() {
+        if (++m_generation == 0) ++m_generation;
+        return m_generation;
+    }
+
+    bool cq_empty() const {
+        return *m_cq_head == __atomic_load_n(m_cq_tail, __ATOMIC_ACQUIRE);
+    }
+
+    io_uring_sqe* next_sqe() {
+        auto tail = *m_sq_tail;
+        if (tail - __atomic_load_n(m_sq_head, __ATOMIC_ACQUIRE) == m_sq_entries) {
+            // submission queue is full, hand it over to the kernel
+            auto res = sys_io_uring_enter(m_ringfd, m_to_submit, 0, 0);
+            if (res < 0) {
+                perror("io_uring_enter() failed");
+                CPPA_CRITICAL("io_uring_enter() failed");
+            }
+            m_to_submit -= static_cast<unsigned>(res);
+        }
+        auto sqe = &m_sqes[tail & m_sq_mask];
+        memset(sqe, 0, sizeof(io_uring_sqe));
+        return sqe;
+    }
+
+    void commit_sqe() {
+        auto tail = *m_sq_tail;
+        m_sq_array[tail & m_sq_mask] = tail & m_sq_mask;
+        __atomic_store_n(m_sq_tail, tail + 1, __ATOMIC_RELEASE);
+        ++m_to_submit;
+    }
+
+    // cancels the pending poll request of @p reg (if any); completions
+    // of the old request are filtered by bumping the generation
+    void disarm(int fd, registration& reg) {
+        if (reg.armed) {
+            auto sqe = next_sqe();
+            sqe->opcode = IORING_OP_POLL_REMOVE;
+            sqe->fd = -1;
+            sqe->addr = to_user_data(fd, reg.generation);
+            sqe->user_data = ignored_completion;
+            commit_sqe();
+            reg.armed = false;
+        }
+        reg.generation = next_generation();
+    }
+
+    void dispatch(std::uint64_t user_data, std::int32_t res) {
+        if (user_data == ignored_completion) return;
+        auto fd = static_cast<int>(user_data & 0xFFFFFFFF);
+        auto generation = static_cast<std::uint32_t>(user_data >> 32);
+        auto i = m_registrations.find(fd);
+        if (i == m_registrations.end() || i->second.generation != generation) {
+            // completion of a cancelled request
+            return;
+        }
+        auto& reg = i->second;
+        reg.armed = false;
+        m_unarmed.push_back(fd);
+        auto eb = res < 0 ? event::error
+                          : from_int_bitmask<input_event,
+                                             output_event,
+                                             error_event>(static_cast<unsigned>(res));
+        if (eb != event::none) m_events.emplace_back(eb, reg.ptr);
+    }
+
+    int m_ringfd;
+
+    void* m_sq_ring;
+    void* m_cq_ring;
+    io_uring_sqe* m_sqes;
+
+    size_t m_sq_ring_size;
+    size_t m_cq_ring_size;
+    size_t m_sqes_size;
+
+    unsigned* m_sq_head;
+    unsigned* m_sq_tail;
+    unsigned* m_sq_array;
+    unsigned m_sq_mask;
+    unsigned m_sq_entries;
+
+    unsigned* m_cq_head;
+    unsigned* m_cq_tail;
+    io_uring_cqe* m_cqes;
+    unsigned m_cq_mask;
+
+    // number of committed but not yet submitted entries
+    unsigned m_to_submit;
+
+    std::uint32_t m_generation;
+
+    // must remain valid until the kernel has consumed the timeout request
+    __kernel_timespec m_timeout;
+
+    std::unordered_map<int, registration> m_registrations;
+
+    // sockets waiting for their poll request being (re)submitted
+    std::vector<int> m_unarmed;
+
+};
+
+} // namespace <anonymous>
+
+std::unique_ptr<middleman_event_handler> middleman_event_handler::create() {
+    std::unique_ptr<middleman_event_handler_impl> ptr{new middleman_event_handler_impl};
+    if (ptr->setup()) {
+        return std::unique_ptr<middleman_event_handler>{ptr.release()};
+    }
+    CPPA_LOGF_INFO("io_uring not available, use epoll instead");
+    return create_epoll_event_handler();
+}
+
+} // namespace io
+} // namespace cppa
+
+#else // defined(CPPA_LINUX) && defined(CPPA_IO_URING_IMPL)
+
+int keep_compiler_happy_for_io_uring_impl() { return 42; }
+
+#endif // defined(CPPA_LINUX) && defined(CPPA_IO_URING_IMPL)
@@ -72,17 +72,17 @@ class middleman_event_handler_impl : public middleman_event_handler {
 
  protected:
 
-    void poll_impl() {
+    void poll_impl(int timeout) {
         CPPA_REQUIRE(m_pollset.empty() == false);
         CPPA_REQUIRE(m_pollset.size() == m_meta.size());
         int presult = -1;
         while (presult < 0) {
 #ifdef CPPA_WINDOWS
-            presult = ::WSAPoll(m_pollset.data(), m_pollset.size(), -1);
+            presult = ::WSAPoll(m_pollset.data(), m_pollset.size(), timeout);
 #else
             presult = ::poll(m_pollset.data(),
                              static_cast<nfds_t>(m_pollset.size()),
-                             -1);
+                             timeout);
 #endif
             CPPA_LOG_DEBUG("poll() on " << num_sockets()
                            << " sockets returned " << presult);
@@ -22,14 +22,24 @@
 namespace cppa {
 namespace detail {
 
-object_array::object_array() : super(true) { }
+object_array::object_array() : super(true), m_type_names(nullptr) { }
+
+object_array::object_array(object_array&& other)
+: super(other), m_elements(std::move(other.m_elements))
+, m_type_names(other.m_type_names.exchange(nullptr)) { }
+
+object_array::object_array(const object_array& other)
+: super(other), m_elements(other.m_elements)
+, m_type_names(other.m_type_names.load()) { }
 
 void object_array::push_back(const object& what) {
     m_elements.push_back(what);
+    m_type_names = nullptr;
 }
 
 void object_array::push_back(object&& what) {
     m_elements.push_back(std::move(what));
+    m_type_names = nullptr;
 }
 
 void* object_array::mutable_at(size_t pos) {
@@ -53,7 +63,12 @@ const uniform_type_info* object_array::type_at(size_t pos) const {
 }
 
 const std::string* object_array::tuple_type_names() const {
-    return nullptr; // get_tuple_type_names(*this);
+    auto result = m_type_names.load(std::memory_order_relaxed);
+    if (!result) {
+        result = interned_tuple_type_names(*this);
+        m_type_names.store(result, std::memory_order_relaxed);
+    }
+    return result;
 }
 
 } // namespace util
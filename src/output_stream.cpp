@@ -24,5 +24,16 @@ namespace io {
 
 output_stream::~output_stream() { }
 
+size_t output_stream::write_some_vec(const io_slice* slices,
+                                     size_t num_slices) {
+    size_t result = 0;
+    for (size_t i = 0; i < num_slices; ++i) {
+        auto written = write_some(slices[i].data, slices[i].size);
+        result += written;
+        if (written < slices[i].size) return result;
+    }
+    return result;
+}
+
 } // namespace io
 } // namespace cppa
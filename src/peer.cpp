@@ -17,14 +17,16 @@
 \******************************************************************************/
 
 
+#include <chrono>
 #include <cstring>
 #include <cstdint>
+#include <algorithm>
+#include <stdexcept>
 
-#include "cppa/on.hpp"
 #include "cppa/cppa.hpp"
 #include "cppa/actor.hpp"
-#include "cppa/match.hpp"
 #include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
 #include "cppa/to_string.hpp"
 #include "cppa/singletons.hpp"
 #include "cppa/exit_reason.hpp"
@@ -34,6 +36,7 @@
 #include "cppa/binary_deserializer.hpp"
 
 #include "cppa/util/algorithm.hpp"
+#include "cppa/util/compression.hpp"
 
 #include "cppa/detail/demangle.hpp"
 #include "cppa/detail/raw_access.hpp"
@@ -43,32 +46,228 @@
 
 #include "cppa/io/peer.hpp"
 #include "cppa/io/middleman.hpp"
+#include "cppa/io/shm_acceptor.hpp"
+#include "cppa/io/shm_io_stream.hpp"
+#include "cppa/io/unix_io_stream.hpp"
 
 using namespace std;
 
 namespace cppa {
 namespace io {
 
+namespace {
+
+// initial size of the receive buffer; the buffer grows temporarily
+// if a single message does not fit into it
+constexpr size_t default_receive_window = 64 * 1024;
+
+inline size_t receive_window() {
+    return std::min(default_receive_window, max_msg_size());
+}
+
+// maximum number of signatures a remote actor may claim to have
+constexpr std::uint32_t max_iface_size = 100;
+
+// maximum size of a single signature of a remote actor
+constexpr std::uint32_t max_iface_clause_size = 500;
+
+// size of actor id, process id, host id and number of signatures
+constexpr size_t handshake_size =   sizeof(actor_id) + sizeof(uint32_t)
+                                  + node_id::host_id_size + sizeof(uint32_t);
+
+// maximum number of types in the type dictionary of a remote node
+constexpr std::uint32_t max_type_dictionary_size = 10000;
+
+// the receive buffer grows in steps of this size
+constexpr size_t receive_chunk_size = 512;
+
+// the receive buffer must be able to hold a message, a signature
+// of the remote actor, or the type dictionary of the remote node
+inline size_t max_receive_buffer_size() {
+    return std::max({max_msg_size(),
+                     size_t{max_iface_clause_size},
+                     max_type_dictionary_size * sizeof(uint64_t)});
+}
+
+// announced along with the type dictionary if compact_wire_format()
+// is enabled; the compact format is used if both nodes announce it
+constexpr std::uint32_t compact_format_feature = 0x01;
+
+// announced by nodes accepting compressed frames
+constexpr std::uint32_t compression_feature = 0x02;
+
+// FNV-1a hash of a uniform type name
+uint64_t type_name_hash(const string& name) {
+    uint64_t result = 14695981039346656037ULL;
+    for (auto c : name) {
+        result ^= static_cast<uint8_t>(c);
+        result *= 1099511628211ULL;
+    }
+    return result;
+}
+
+// marks frames that carry a control message of the peer protocol
+// instead of a message for an actor
+constexpr std::uint32_t control_frame_flag = 0x80000000;
+
+// marks frames that carry a chunk of a large message
+constexpr std::uint32_t chunk_frame_flag = 0x40000000;
+
+// marks frames serialized without address aliases, i.e., frames
+// that may overtake frames written earlier
+constexpr std::uint32_t unaliased_frame_flag = 0x20000000;
+
+// marks frames with compressed content, see util::compress()
+constexpr std::uint32_t compressed_frame_flag = 0x10000000;
+
+constexpr std::uint32_t frame_flags =   control_frame_flag | chunk_frame_flag
+                                      | unaliased_frame_flag
+                                      | compressed_frame_flag;
+
+// messages exceeding this size are sent in chunks of at most this size,
+// interleaved with other frames of the connection
+constexpr size_t max_chunk_size = 64 * 1024;
+
+// each chunk starts with the transfer ID and the total message size
+constexpr size_t chunk_header_size = 2 * sizeof(std::uint32_t);
+
+// maximum number of partially received messages per connection
+constexpr size_t max_incoming_transfers = 256;
+
+// maximum number of bytes reserved for partially received messages
+// per connection, i.e., the sum of their total sizes
+inline size_t max_incoming_transfer_bytes() {
+    return 4 * max_msg_size();
+}
+
+// number of recently serialized messages kept per connection
+constexpr size_t max_cached_payloads = 4;
+
+// number of recently sent tuples remembered per connection; the payload
+// of a tuple is cached when it is sent again
+constexpr size_t max_sent_payloads = 16;
+
+// payloads exceeding this size are never cached
+constexpr size_t max_cached_payload_size = 256 * 1024;
+
+typedef std::chrono::steady_clock clock_type;
+
+// each middleman thread spends at most compression_budget per
+// compression_period compressing frames and sends frames
+// uncompressed once it has exhausted its budget
+constexpr auto compression_budget = std::chrono::milliseconds(200);
+
+constexpr auto compression_period = std::chrono::seconds(1);
+
+// start of the current compression period and the time spent
+// compressing in it, both in clock ticks
+__thread clock_type::rep t_compression_period_start = 0;
+__thread clock_type::rep t_compression_time = 0;
+
+bool compression_budget_left(clock_type::time_point now) {
+    clock_type::time_point period_start{
+        clock_type::duration{t_compression_period_start}};
+    if (now - period_start >= compression_period) {
+        t_compression_period_start = now.time_since_epoch().count();
+        t_compression_time = 0;
+    }
+    return clock_type::duration{t_compression_time} < compression_budget;
+}
+
+// control messages are sent as tuples by proxies and the middleman,
+// but transmitted as type tag followed by the sender and the
+// tuple elements without the leading atom
+enum control_type : std::uint8_t {
+    no_control,
+    monitor_msg,    // {'MONITOR', node_id_ptr, actor_id}
+    kill_proxy_msg, // {'KILL_PROXY', node_id_ptr, actor_id, exit reason}
+    link_msg,       // {'LINK', actor_addr}
+    unlink_msg,     // {'UNLINK', actor_addr}
+    add_type_msg    // {'ADD_TYPE', type id, uniform type name}
+};
+
+control_type control_type_of(const string& tname, const any_tuple& msg) {
+    // all control messages start with an atom followed by arguments
+    if (msg.size() < 2 || tname.compare(0, 9, "@<>+@atom") != 0) {
+        return no_control;
+    }
+    auto what = msg.get_as<atom_value>(0);
+    if (what == atom("MONITOR")) {
+        return tname == "@<>+@atom+@proc+@u32" ? monitor_msg : no_control;
+    }
+    if (what == atom("KILL_PROXY")) {
+        return tname == "@<>+@atom+@proc+@u32+@u32" ? kill_proxy_msg
+                                                     : no_control;
+    }
+    if (what == atom("LINK")) {
+        return tname == "@<>+@atom+@addr" ? link_msg : no_control;
+    }
+    if (what == atom("UNLINK")) {
+        return tname == "@<>+@atom+@addr" ? unlink_msg : no_control;
+    }
+    if (what == atom("ADD_TYPE")) {
+        return tname == "@<>+@atom+@u32+@str" ? add_type_msg : no_control;
+    }
+    return no_control;
+}
+
+string iface_to_string(const set<string>& what) {
+    if (what.empty()) return "actor";
+    string tmp;
+    tmp = "typed_actor<";
+    auto i = what.begin();
+    auto e = what.end();
+    tmp += *i++;
+    while (i != e) tmp += *i++;
+    tmp += ">";
+    return tmp;
+}
+
+string iface_mismatch(const set<string>& expected, const set<string>& found) {
+    auto found_str = iface_to_string(found);
+    auto expected_str = iface_to_string(expected);
+    if (expected.empty()) {
+        return "expected remote actor to be a dynamically typed actor "
+               "but found a strongly typed actor of type " + found_str;
+    }
+    if (found.empty()) {
+        return "expected remote actor to be a strongly typed actor of type "
+               + expected_str + " but found a dynamically typed actor";
+    }
+    return "expected remote actor to be a strongly typed actor of type "
+           + expected_str + " but found a strongly typed actor of type "
+           + found_str;
+}
+
+} // namespace <anonymous>
+
 peer::peer(middleman* parent,
            const input_stream_ptr& in,
            const output_stream_ptr& out,
            node_id_ptr peer_ptr)
 : super(parent, out, in->read_handle(), out->write_handle())
 , m_in(in), m_state((peer_ptr) ? wait_for_msg_size : wait_for_process_info)
-, m_node(peer_ptr) {
-    m_rd_buf.final_size( m_state == wait_for_process_info
-                       ? sizeof(uint32_t) + node_id::host_id_size
-                       : sizeof(uint32_t));
+, m_node(peer_ptr), m_msg_size(0), m_control_frame(false), m_chunk_frame(false)
+, m_aliased_frame(true), m_compressed_frame(false)
+, m_priority_lane_ready(false), m_compact(false)
+, m_compression_supported(false)
+, m_rd_buf(receive_chunk_size, max_receive_buffer_size())
+, m_remote_aid(0), m_pending_signatures(0), m_process_info_pending(false)
+, m_next_transfer_id(0), m_incoming_transfer_bytes(0) {
+    m_rd_buf.final_size(receive_window());
     // state == wait_for_msg_size iff peer was created using remote_peer()
     // in this case, this peer must be erased if no proxy of it remains
     m_stop_on_last_proxy_exited = m_state == wait_for_msg_size;
     m_meta_hdr = uniform_typeid<message_header>();
     m_meta_msg = uniform_typeid<any_tuple>();
+    m_meta_node = uniform_typeid<node_id_ptr>();
 }
 
 void peer::io_failed(event_bitmask mask) {
     CPPA_LOG_TRACE("node = " << (m_node ? to_string(*m_node) : "nullptr")
                    << " mask = " << mask);
+    handshake_done(nullptr, make_exception_ptr(
+        network_error("IO failure during handshake")));
     // make sure this code is executed only once by filtering for read failure
     if (mask == event::read && m_node) {
         // kill all proxies
@@ -87,99 +286,541 @@ void peer::io_failed(event_bitmask mask) {
 continue_reading_result peer::continue_reading() {
     CPPA_LOG_TRACE("");
     for (;;) {
+        auto free_space = m_rd_buf.remaining();
+        auto before = m_rd_buf.size();
         try { m_rd_buf.append_from(m_in.get()); }
         catch (exception&) {
             return continue_reading_result::failure;
         }
-        if (!m_rd_buf.full()) {
+        auto received = m_rd_buf.size() - before;
+        if (received == 0) {
             // try again later
             return continue_reading_result::continue_later;
         }
-        switch (m_state) {
-            case wait_for_process_info: {
-                //DEBUG("peer_connection::continue_reading: "
-                //      "wait_for_process_info");
-                uint32_t process_id;
-                node_id::host_id_type host_id;
-                memcpy(&process_id, m_rd_buf.data(), sizeof(uint32_t));
-                memcpy(host_id.data(), m_rd_buf.offset_data(sizeof(uint32_t)),
-                       node_id::host_id_size);
-                m_node.reset(new node_id(process_id, host_id));
-                if (*parent()->node() == *m_node) {
-                    CPPA_LOG_INFO("incoming connection from self");
-                    return continue_reading_result::failure;
+        // consume all complete frames in the buffer
+        size_t pos = 0;
+        for (bool done = false; !done; ) {
+            auto available = m_rd_buf.size() - pos;
+            switch (m_state) {
+                case wait_for_process_info: {
+                    auto pinf_size = sizeof(uint32_t) + node_id::host_id_size;
+                    if (available < pinf_size) done = true;
+                    else {
+                        if (!handle_process_info(m_rd_buf.offset_data(pos))) {
+                            return continue_reading_result::failure;
+                        }
+                        pos += pinf_size;
+                        m_state = wait_for_type_count;
+                    }
+                    break;
+                }
+                case wait_for_handshake: {
+                    if (available < handshake_size) done = true;
+                    else {
+                        if (!handle_handshake(m_rd_buf.offset_data(pos))) {
+                            return continue_reading_result::failure;
+                        }
+                        pos += handshake_size;
+                    }
+                    break;
+                }
+                case wait_for_signature_size: {
+                    if (available < sizeof(uint32_t)) done = true;
+                    else {
+                        memcpy(&m_msg_size, m_rd_buf.offset_data(pos),
+                               sizeof(uint32_t));
+                        if (m_msg_size > max_iface_clause_size) {
+                            handshake_done(nullptr, make_exception_ptr(
+                                invalid_argument("Remote actor claims to "
+                                                 "have a signature with "
+                                                 "more than "
+                                                 + std::to_string(max_iface_clause_size)
+                                                 + " characters? Someone is "
+                                                 "trying something nasty!")));
+                            return continue_reading_result::failure;
+                        }
+                        pos += sizeof(uint32_t);
+                        m_state = read_signature;
+                    }
+                    break;
+                }
+                case read_signature: {
+                    if (available < m_msg_size) done = true;
+                    else {
+                        if (!handle_signature(m_rd_buf.offset_data(pos),
+                                              m_msg_size)) {
+                            return continue_reading_result::failure;
+                        }
+                        pos += m_msg_size;
+                    }
+                    break;
+                }
+                case wait_for_type_count: {
+                    if (available < 2 * sizeof(uint32_t)) done = true;
+                    else {
+                        uint32_t features;
+                        uint32_t count;
+                        memcpy(&features, m_rd_buf.offset_data(pos),
+                               sizeof(uint32_t));
+                        memcpy(&count,
+                               m_rd_buf.offset_data(pos + sizeof(uint32_t)),
+                               sizeof(uint32_t));
+                        // use features only if enabled on both sides
+                        m_compact = m_compact
+                                    && (features & compact_format_feature);
+                        m_compression_supported =
+                            (features & compression_feature) != 0;
+                        if (count > max_type_dictionary_size) {
+                            CPPA_LOG_ERROR("type dictionary exceeds "
+                                           "max. size: " << count);
+                            return continue_reading_result::failure;
+                        }
+                        m_msg_size = count * sizeof(uint64_t);
+                        pos += 2 * sizeof(uint32_t);
+                        m_state = read_type_dictionary;
+                    }
+                    break;
+                }
+                case read_type_dictionary: {
+                    if (available < m_msg_size) done = true;
+                    else {
+                        auto data = m_rd_buf.offset_data(pos);
+                        pos += m_msg_size;
+                        if (!handle_type_dictionary(data, m_msg_size)) {
+                            return continue_reading_result::failure;
+                        }
+                    }
+                    break;
                 }
-                CPPA_LOG_DEBUG("read process info: " << to_string(*m_node));
-                if (!parent()->register_peer(*m_node, this)) {
-                    CPPA_LOG_INFO("multiple incoming connections "
-                                  "from the same node");
-                    return continue_reading_result::failure;
+                case wait_for_msg_size: {
+                    if (available < sizeof(uint32_t)) done = true;
+                    else {
+                        memcpy(&m_msg_size, m_rd_buf.offset_data(pos),
+                               sizeof(uint32_t));
+                        m_control_frame = (m_msg_size & control_frame_flag) != 0;
+                        m_chunk_frame = (m_msg_size & chunk_frame_flag) != 0;
+                        m_aliased_frame = (m_msg_size & unaliased_frame_flag) == 0;
+                        m_compressed_frame = (m_msg_size & compressed_frame_flag) != 0;
+                        m_msg_size &= ~frame_flags;
+                        if (m_control_frame && m_compressed_frame) {
+                            CPPA_LOG_ERROR("compressed control frame");
+                            return continue_reading_result::failure;
+                        }
+                        if (m_msg_size > max_msg_size()) {
+                            CPPA_LOG_ERROR("incoming message exceeds "
+                                           "max_msg_size(): " << m_msg_size);
+                            return continue_reading_result::failure;
+                        }
+                        pos += sizeof(uint32_t);
+                        m_state = read_message;
+                    }
+                    break;
+                }
+                case read_message: {
+                    if (available < m_msg_size) done = true;
+                    else {
+                        auto data = m_rd_buf.offset_data(pos);
+                        bool ok;
+                        if (m_control_frame) {
+                            ok = handle_control(data, m_msg_size,
+                                                m_aliased_frame);
+                        }
+                        else if (m_chunk_frame) {
+                            ok = handle_chunk(data, m_msg_size,
+                                              m_compressed_frame);
+                        }
+                        else if (m_compressed_frame) {
+                            ok = handle_compressed(data, m_msg_size,
+                                                   m_aliased_frame);
+                        }
+                        else {
+                            ok = handle_message(data, m_msg_size,
+                                                m_aliased_frame);
+                        }
+                        if (!ok) {
+                            return continue_reading_result::failure;
+                        }
+                        pos += m_msg_size;
+                        m_state = wait_for_msg_size;
+                    }
+                    break;
                 }
-                // initialization done
-                m_state = wait_for_msg_size;
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
+            }
+        }
+        // move a partially received frame to the front of the buffer
+        m_rd_buf.erase_leading(pos);
+        // make sure the buffer is large enough for the pending frame
+        if (   (   m_state == read_message
+                || m_state == read_signature
+                || m_state == read_type_dictionary)
+            && m_msg_size > m_rd_buf.final_size()) {
+            m_rd_buf.final_size(m_msg_size);
+        }
+        else if (m_rd_buf.final_size() > receive_window()
+                 && m_rd_buf.size() <= receive_window()) {
+            m_rd_buf.final_size(receive_window());
+        }
+        if (received < free_space) {
+            // socket has been drained, no need for another recv() call
+            return continue_reading_result::continue_later;
+        }
+        // try to read more (next iteration)
+    }
+}
+
+bool peer::handle_process_info(const void* buf) {
+    uint32_t process_id;
+    node_id::host_id_type host_id;
+    memcpy(&process_id, buf, sizeof(uint32_t));
+    memcpy(host_id.data(), static_cast<const char*>(buf) + sizeof(uint32_t),
+           node_id::host_id_size);
+    m_node.reset(new node_id(process_id, host_id));
+    if (*parent()->node() == *m_node) {
+        CPPA_LOG_INFO("incoming connection from self");
+        return false;
+    }
+    CPPA_LOG_DEBUG("read process info: " << to_string(*m_node));
+    return true;
+}
+
+void peer::send_type_dictionary() {
+    m_local_types.clear();
+    for (auto uti : get_uniform_type_info_map()->get_all()) {
+        // types of the default table already have an ID
+        if (m_outgoing_types.id_of(uti) == 0) {
+            m_local_types.emplace_back(type_name_hash(uti->name()), uti);
+        }
+    }
+    sort(m_local_types.begin(), m_local_types.end());
+    // names with colliding hashes are left out
+    auto first = m_local_types.begin();
+    auto last = m_local_types.end();
+    vector<pair<uint64_t, const uniform_type_info*>> unique_types;
+    for (auto i = first; i != last; ) {
+        auto j = find_if(i, last, [&](const pair<uint64_t,
+                                                 const uniform_type_info*>& x) {
+            return x.first != i->first;
+        });
+        if (j - i == 1) unique_types.push_back(*i);
+        i = j;
+    }
+    m_local_types.swap(unique_types);
+    m_compact = compact_wire_format();
+    // compressed frames are always accepted, whether or not
+    // this node compresses frames itself
+    uint32_t features = compression_feature;
+    if (m_compact) features |= compact_format_feature;
+    auto count = static_cast<uint32_t>(m_local_types.size());
+    auto& wbuf = write_buffer();
+    wbuf.write(sizeof(uint32_t), &features);
+    wbuf.write(sizeof(uint32_t), &count);
+    for (auto& kvp : m_local_types) {
+        wbuf.write(sizeof(uint64_t), &kvp.first);
+    }
+    register_for_writing();
+}
+
+bool peer::handle_type_dictionary(const void* buf, size_t buf_size) {
+    vector<uint64_t> remote_hashes(buf_size / sizeof(uint64_t));
+    memcpy(remote_hashes.data(), buf, buf_size);
+    sort(remote_hashes.begin(), remote_hashes.end());
+    // both sides assign IDs to common types in ascending order of
+    // their hashes, starting after the default types
+    auto id = m_outgoing_types.max_id() + 1;
+    for (auto& kvp : m_local_types) {
+        if (binary_search(remote_hashes.begin(), remote_hashes.end(),
+                          kvp.first)) {
+            m_outgoing_types.emplace(id, kvp.second);
+            m_incoming_types.emplace(id, kvp.second);
+            ++id;
+        }
+    }
+    CPPA_LOG_DEBUG("negotiated " << (id - m_outgoing_types.max_id() - 1)
+                   << " type IDs");
+    m_local_types.clear();
+    m_local_types.shrink_to_fit();
+    // the connecting side still has to check the remote actor
+    if (m_remote_node) return finalize_handshake();
+    if (!parent()->register_peer(*m_node, this)) {
+        CPPA_LOG_INFO("multiple incoming connections "
+                      "from the same node");
+        return false;
+    }
+    m_state = wait_for_msg_size;
+    return true;
+}
+
+void peer::start_handshake(set<string> expected_iface,
+                           handshake_handler hdl) {
+    CPPA_LOG_TRACE("");
+    m_state = wait_for_handshake;
+    m_expected_iface = move(expected_iface);
+    m_handshake_handler = move(hdl);
+#   ifdef CPPA_LINUX
+    // wait for the handshake of the remote node, which
+    // might turn out to be a process on the same host
+    if (shm_transport()
+            && dynamic_cast<shm_io_stream*>(m_in.get()) == nullptr) {
+        m_process_info_pending = true;
+        return;
+    }
+#   endif
+    send_process_info();
+}
+
+void peer::send_process_info() {
+    auto& pinf = parent()->node();
+    uint32_t process_id = pinf->process_id();
+    write(sizeof(uint32_t), &process_id);
+    write(pinf->host_id().size(), pinf->host_id().data());
+    send_type_dictionary();
+}
+
+bool peer::reconnect_via_shm() {
+#   ifdef CPPA_LINUX
+    auto& self = *parent()->node();
+    if (m_remote_node->host_id() != self.host_id()
+            || m_remote_node->process_id() == self.process_id()
+            || parent()->get_peer(*m_remote_node) != nullptr) {
+        return false;
+    }
+    stream_ptr channel;
+    auto path = shm_acceptor::endpoint(*m_remote_node, m_remote_aid);
+    try { channel = unix_io_stream::connect_to(path); }
+    catch (network_error&) {
+        CPPA_LOG_INFO("no shared memory endpoint for actor " << m_remote_aid
+                      << " of " << to_string(*m_remote_node));
+        return false;
+    }
+    CPPA_LOG_INFO("reconnect to " << to_string(*m_remote_node)
+                  << " via shared memory");
+    auto mm = parent();
+    auto iface = m_expected_iface;
+    auto hdl = move(m_handshake_handler);
+    m_handshake_handler = nullptr;
+    shm_io_stream::async_connect(mm, move(channel),
+                                 [=](stream_ptr ptr, exception_ptr eptr) {
+        if (eptr) hdl(nullptr, eptr);
+        else mm->new_client_peer(ptr, ptr, iface, hdl);
+    });
+    return true;
+#   else
+    return false;
+#   endif
+}
+
+bool peer::handle_handshake(const void* buf) {
+    auto bytes = static_cast<const char*>(buf);
+    uint32_t process_id;
+    node_id::host_id_type host_id;
+    memcpy(&m_remote_aid, bytes, sizeof(actor_id));
+    bytes += sizeof(actor_id);
+    memcpy(&process_id, bytes, sizeof(uint32_t));
+    bytes += sizeof(uint32_t);
+    memcpy(host_id.data(), bytes, node_id::host_id_size);
+    bytes += node_id::host_id_size;
+    memcpy(&m_pending_signatures, bytes, sizeof(uint32_t));
+    m_remote_node.reset(new node_id(process_id, host_id));
+    CPPA_LOG_DEBUG("read handshake of " << to_string(*m_remote_node)
+                   << ", remote actor id = " << m_remote_aid
+                   << ", " << m_pending_signatures << " signatures");
+    if (m_pending_signatures > max_iface_size) {
+        handshake_done(nullptr, make_exception_ptr(
+            invalid_argument("Remote actor claims to have more than "
+                             + std::to_string(max_iface_size)
+                             + " message types? Someone is trying"
+                               " something nasty!")));
+        return false;
+    }
+    if (m_process_info_pending) {
+        m_process_info_pending = false;
+        // closes this connection, the remote peer
+        // never receives our process information
+        if (reconnect_via_shm()) return false;
+        send_process_info();
+    }
+    if (m_pending_signatures == 0) {
+        m_state = wait_for_type_count;
+        return true;
+    }
+    m_state = wait_for_signature_size;
+    return true;
+}
+
+bool peer::handle_signature(const void* buf, size_t buf_size) {
+    m_iface.insert(string(static_cast<const char*>(buf), buf_size));
+    m_state = (--m_pending_signatures == 0) ? wait_for_type_count
+                                            : wait_for_signature_size;
+    return true;
+}
+
+bool peer::finalize_handshake() {
+    CPPA_REQUIRE(m_remote_node != nullptr);
+    if (m_iface != m_expected_iface) {
+        handshake_done(nullptr, make_exception_ptr(
+            invalid_argument(iface_mismatch(m_expected_iface, m_iface))));
+        return false;
+    }
+    if (*parent()->node() == *m_remote_node) {
+        // this is a local actor, not a remote actor
+        CPPA_LOG_INFO("remote_actor() called to access a local actor");
+        handshake_done(get_actor_registry()->get(m_remote_aid), nullptr);
+        return false;
+    }
+    auto& ns = parent()->get_namespace();
+    if (parent()->get_peer(*m_remote_node)) {
+        CPPA_LOG_INFO("connection already exists (re-use old one)");
+        handshake_done(ns.get_or_put(m_remote_node, m_remote_aid), nullptr);
+        return false;
+    }
+    m_node = move(m_remote_node);
+    m_state = wait_for_msg_size;
+    m_stop_on_last_proxy_exited = true;
+    parent()->register_peer(*m_node, this);
+    handshake_done(ns.get_or_put(m_node, m_remote_aid), nullptr);
+    return true;
+}
+
+void peer::handshake_done(abstract_actor_ptr ptr, exception_ptr eptr) {
+    if (!m_handshake_handler) return;
+    auto hdl = move(m_handshake_handler);
+    m_handshake_handler = nullptr;
+    hdl(move(ptr), move(eptr));
+}
+
+bool peer::handle_message(const void* buf, size_t buf_size, bool aliased,
+                          util::shared_buffer_ptr storage) {
+    message_header hdr;
+    any_tuple msg;
+    binary_deserializer bd(buf, buf_size, &(parent()->get_namespace()),
+                           &m_incoming_types,
+                           aliased ? &m_incoming_addresses : nullptr);
+    bd.compact(m_compact);
+    bd.storage(std::move(storage));
+    try {
+        m_meta_hdr->deserialize(&hdr, &bd);
+        m_meta_msg->deserialize(&msg, &bd);
+    }
+    catch (exception& e) {
+        CPPA_LOG_ERROR("exception during read_message: "
+                       << detail::demangle(typeid(e))
+                       << ", what(): " << e.what());
+        return false;
+    }
+    CPPA_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
+    deliver(hdr, move(msg));
+    return true;
+}
+
+bool peer::handle_compressed(const void* buf, size_t buf_size, bool aliased) {
+    util::shared_buffer_ptr storage{new util::shared_buffer};
+    auto& sbuf = storage->get();
+    if (!util::decompress(buf, buf_size, sbuf, max_msg_size())) {
+        CPPA_LOG_ERROR("cannot decompress frame");
+        return false;
+    }
+    return handle_message(sbuf.data(), sbuf.size(), aliased, storage);
+}
+
+bool peer::handle_chunk(const void* buf, size_t buf_size, bool compressed) {
+    if (buf_size < chunk_header_size) {
+        CPPA_LOG_ERROR("chunk frame without header");
+        return false;
+    }
+    auto bytes = static_cast<const char*>(buf);
+    uint32_t id;
+    uint32_t total;
+    memcpy(&id, bytes, sizeof(uint32_t));
+    memcpy(&total, bytes + sizeof(uint32_t), sizeof(uint32_t));
+    auto i = m_incoming_transfers.find(id);
+    if (i == m_incoming_transfers.end()) {
+        if (   total > max_msg_size()
+            || m_incoming_transfers.size() >= max_incoming_transfers
+            ||   m_incoming_transfer_bytes + total
+               > max_incoming_transfer_bytes()) {
+            CPPA_LOG_ERROR("rejected chunked message of size " << total);
+            return false;
+        }
+        i = m_incoming_transfers.emplace(id, incoming_transfer{}).first;
+        // the final size of the buffer stores the total message size
+        i->second.data.final_size(total);
+        i->second.compressed = compressed;
+        m_incoming_transfer_bytes += total;
+    }
+    auto& tbuf = i->second.data;
+    auto data_size = buf_size - chunk_header_size;
+    if (   total != tbuf.final_size()
+        || tbuf.size() + data_size > tbuf.final_size()
+        || compressed != i->second.compressed) {
+        CPPA_LOG_ERROR("chunk does not match its message");
+        return false;
+    }
+    tbuf.write(data_size, bytes + chunk_header_size);
+    if (tbuf.size() < total) return true;
+    m_incoming_transfer_bytes -= total;
+    if (compressed) {
+        auto tmp = move(tbuf);
+        m_incoming_transfers.erase(i);
+        return handle_compressed(tmp.data(), tmp.size(), false);
+    }
+    // the reassembled message has a buffer of its own, which allows
+    // byte slices in the message to refer to it instead of copying
+    util::shared_buffer_ptr storage{new util::shared_buffer(move(tbuf))};
+    m_incoming_transfers.erase(i);
+    auto& sbuf = storage->get();
+    return handle_message(sbuf.data(), sbuf.size(), false, storage);
+}
+
+bool peer::handle_control(const void* buf, size_t buf_size, bool aliased) {
+    auto& ns = parent()->get_namespace();
+    binary_deserializer bd(buf, buf_size, &ns, &m_incoming_types,
+                           aliased ? &m_incoming_addresses : nullptr);
+    bd.compact(m_compact);
+    try {
+        auto type = bd.read<uint8_t>();
+        auto sender = ns.read(&bd);
+        switch (type) {
+            case monitor_msg: {
+                node_id_ptr node;
+                m_meta_node->deserialize(&node, &bd);
+                auto aid = bd.read<actor_id>();
+                monitor(sender, node, aid);
                 break;
             }
-            case wait_for_msg_size: {
-                //DEBUG("peer_connection::continue_reading: wait_for_msg_size");
-                uint32_t msg_size;
-                memcpy(&msg_size, m_rd_buf.data(), sizeof(uint32_t));
-                m_rd_buf.clear();
-                m_rd_buf.final_size(msg_size);
-                m_state = read_message;
+            case kill_proxy_msg: {
+                node_id_ptr node;
+                m_meta_node->deserialize(&node, &bd);
+                auto aid = bd.read<actor_id>();
+                auto reason = bd.read<uint32_t>();
+                kill_proxy(sender, node, aid, reason);
                 break;
             }
-            case read_message: {
-                //DEBUG("peer_connection::continue_reading: read_message");
-                message_header hdr;
-                any_tuple msg;
-                binary_deserializer bd(m_rd_buf.data(), m_rd_buf.size(),
-                                       &(parent()->get_namespace()), &m_incoming_types);
-                try {
-                    m_meta_hdr->deserialize(&hdr, &bd);
-                    m_meta_msg->deserialize(&msg, &bd);
-                }
-                catch (exception& e) {
-                    CPPA_LOG_ERROR("exception during read_message: "
-                                   << detail::demangle(typeid(e))
-                                   << ", what(): " << e.what());
-                    return continue_reading_result::failure;
-                }
-                CPPA_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
-                match(msg) (
-                    // monitor messages are sent automatically whenever
-                    // actor_proxy_cache creates a new proxy
-                    // note: aid is the *original* actor id
-                    on(atom("MONITOR"), arg_match) >> [&](const node_id_ptr& node, actor_id aid) {
-                        monitor(hdr.sender, node, aid);
-                    },
-                    on(atom("KILL_PROXY"), arg_match) >> [&](const node_id_ptr& node, actor_id aid, std::uint32_t reason) {
-                        kill_proxy(hdr.sender, node, aid, reason);
-                    },
-                    on(atom("LINK"), arg_match) >> [&](const actor_addr& ptr) {
-                        link(hdr.sender, ptr);
-                    },
-                    on(atom("UNLINK"), arg_match) >> [&](const actor_addr& ptr) {
-                        unlink(hdr.sender, ptr);
-                    },
-                    on(atom("ADD_TYPE"), arg_match) >> [&](std::uint32_t id, const std::string& name) {
-                        auto imap = get_uniform_type_info_map();
-                        auto uti = imap->by_uniform_name(name);
-                        m_incoming_types.emplace(id, uti);
-                    },
-                    others() >> [&] {
-                        deliver(hdr, move(msg));
-                    }
-                );
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
-                m_state = wait_for_msg_size;
+            case link_msg:
+                link(sender, ns.read(&bd));
+                break;
+            case unlink_msg:
+                unlink(sender, ns.read(&bd));
+                break;
+            case add_type_msg: {
+                auto id = bd.read<uint32_t>();
+                auto name = bd.read<string>();
+                auto uti = get_uniform_type_info_map()->by_uniform_name(name);
+                m_incoming_types.emplace(id, uti);
                 break;
             }
+            default:
+                CPPA_LOG_ERROR("received invalid control message type: "
+                               << static_cast<int>(type));
+                return false;
         }
-        // try to read more (next iteration)
     }
+    catch (exception& e) {
+        CPPA_LOG_ERROR("exception during handle_control: "
+                       << detail::demangle(typeid(e))
+                       << ", what(): " << e.what());
+        return false;
+    }
+    return true;
 }
 
 void peer::monitor(const actor_addr&,
@@ -326,14 +967,33 @@ void peer::unlink(const actor_addr& lhs, const actor_addr& rhs) {
 continue_writing_result peer::continue_writing() {
     CPPA_LOG_TRACE("");
     auto result = super::continue_writing();
-    while (result == continue_writing_result::done && !queue().empty()) {
-        auto tmp = queue().pop();
-        enqueue(tmp.first, tmp.second);
+    // frames in the priority lane must not overtake the handshake
+    if (result == continue_writing_result::done && !has_unwritten_data()) {
+        m_priority_lane_ready = true;
+    }
+    // m_queue is not set until this peer has been registered,
+    // but peers write handshake data before their registration
+    while (   result == continue_writing_result::done
+           && m_queue != nullptr
+           && !queue().empty()) {
+        flush_queue();
+        result = super::continue_writing();
+    }
+    if (result == continue_writing_result::done
+            && !m_outgoing_transfers.empty()) {
+        write_chunks();
         result = super::continue_writing();
+        // give messages enqueued in the meantime a chance to
+        // overtake the remaining chunks
+        if (   result == continue_writing_result::done
+            && !m_outgoing_transfers.empty()) {
+            return continue_writing_result::continue_later;
+        }
     }
     if (result == continue_writing_result::done
             && stop_on_last_proxy_exited()
-            && !has_unwritten_data()) {
+            && !has_unwritten_data()
+            && m_outgoing_transfers.empty()) {
         if (parent()->get_namespace().count_proxies(*m_node) == 0) {
             parent()->last_proxy_exited(this);
         }
@@ -341,37 +1001,255 @@ continue_writing_result peer::continue_writing() {
     return result;
 }
 
-void peer::add_type_if_needed(const std::string& tname) {
-    if (m_outgoing_types.id_of(tname) == 0) {
+void peer::flush_queue() {
+    CPPA_LOG_TRACE("queue size = " << queue().size());
+    auto& q = queue();
+    if (q.empty()) return;
+    while (!q.empty() && unwritten_bytes() < write_window()) {
+        auto tmp = q.pop();
+        enqueue_impl(tmp.first, tmp.second);
+    }
+    register_for_writing();
+}
+
+void peer::write_chunks() {
+    CPPA_LOG_TRACE("transfers = " << m_outgoing_transfers.size());
+    while (!m_outgoing_transfers.empty()
+           && unwritten_bytes() < write_window()) {
+        // send one chunk per transfer in round-robin order
+        auto& tr = m_outgoing_transfers.front();
+        auto total = static_cast<uint32_t>(tr.data.size());
+        auto data_size = std::min(max_chunk_size, tr.data.size() - tr.pos);
+        auto size =   static_cast<uint32_t>(chunk_header_size + data_size)
+                    | chunk_frame_flag;
+        if (tr.compressed) size |= compressed_frame_flag;
+        auto& wbuf = write_buffer();
+        wbuf.write(sizeof(uint32_t), &size);
+        wbuf.write(sizeof(uint32_t), &tr.id);
+        wbuf.write(sizeof(uint32_t), &total);
+        wbuf.write(data_size, tr.data.offset_data(tr.pos));
+        tr.pos += data_size;
+        if (tr.pos < tr.data.size()) {
+            m_outgoing_transfers.push_back(std::move(tr));
+            m_outgoing_transfers.pop_front();
+        }
+        else {
+            auto backlog = std::move(tr.backlog);
+            m_outgoing_transfers.pop_front();
+            for (auto& kvp : backlog) enqueue_impl(kvp.first, kvp.second);
+        }
+    }
+    register_for_writing();
+}
+
+size_t peer::buffered_bytes() const {
+    auto result = unwritten_bytes();
+    for (auto& tr : m_outgoing_transfers) {
+        result += tr.data.size() - tr.pos;
+        result +=   tr.backlog.size()
+                  * default_message_queue::estimated_message_size;
+    }
+    return result;
+}
+
+void peer::add_type_if_needed(const std::string* tname) {
+    // interned names identify a tuple type, i.e., we only
+    // need to look up a name the first time it is sent
+    if (!m_sent_type_names.insert(tname).second) return;
+    if (m_outgoing_types.id_of(*tname) == 0) {
         auto id = m_outgoing_types.max_id() + 1;
         auto imap = get_uniform_type_info_map();
-        auto uti = imap->by_uniform_name(tname);
+        auto uti = imap->by_uniform_name(*tname);
         m_outgoing_types.emplace(id, uti);
-        enqueue_impl({invalid_actor_addr, nullptr}, make_any_tuple(atom("ADD_TYPE"), id, tname));
+        enqueue_impl({invalid_actor_addr, nullptr}, make_any_tuple(atom("ADD_TYPE"), id, *tname));
     }
 }
 
 void peer::enqueue_impl(msg_hdr_cref hdr, const any_tuple& msg) {
     CPPA_LOG_TRACE("");
+    auto high_priority = hdr.id.is_high_priority();
+    if (hdr.sender && !high_priority) {
+        // messages must not overtake a chunked message of the same sender
+        auto i = find_if(m_outgoing_transfers.begin(),
+                         m_outgoing_transfers.end(),
+                         [&](const outgoing_transfer& tr) {
+                             return tr.sender == hdr.sender;
+                         });
+        if (i != m_outgoing_transfers.end()) {
+            i->backlog.emplace_back(hdr, msg);
+            return;
+        }
+    }
     auto tname = msg.tuple_type_names();
-    add_type_if_needed((tname) ? *tname : detail::get_tuple_type_names(*msg.vals()));
+    auto ctrl = control_type_of(*tname, msg);
+    if (ctrl == no_control) add_type_if_needed(tname);
+    // type announcements always use the priority lane, because they
+    // must arrive before any high-priority message using the type;
+    // frames in the priority lane cannot refer to address aliases
+    // defined by frames they overtake
+    auto prioritized =    m_priority_lane_ready
+                       && (high_priority || ctrl == add_type_msg);
+    if (ctrl == no_control && !prioritized) {
+        auto cp = cached(msg, false);
+        if (cp && cp->data.size() > max_chunk_size) {
+            // sent in chunks before, no need to serialize it with aliases
+            enqueue_chunked(hdr, msg);
+            return;
+        }
+    }
     uint32_t size = 0;
-    auto& wbuf = write_buffer();
+    auto& wbuf = prioritized ? priority_buffer() : write_buffer();
     auto before = static_cast<uint32_t>(wbuf.size());
-    binary_serializer bs(&wbuf, &(parent()->get_namespace()), &m_outgoing_types);
+    auto aliases = m_outgoing_addresses.make_checkpoint();
+    binary_serializer bs(&wbuf, &(parent()->get_namespace()),
+                         &m_outgoing_types,
+                         prioritized ? nullptr : &m_outgoing_addresses);
+    bs.compact(m_compact);
     wbuf.write(sizeof(uint32_t), &size);
-    try { bs << hdr << msg; }
+    try {
+        if (ctrl == no_control) {
+            bs << hdr;
+            write_payload(bs, wbuf, msg, !prioritized);
+        }
+        else {
+            bs.write_value(static_cast<uint8_t>(ctrl));
+            parent()->get_namespace().write(&bs, hdr.sender);
+            for (size_t i = 1; i < msg.size(); ++i) {
+                msg.type_at(i)->serialize(msg.at(i), &bs);
+            }
+        }
+    }
     catch (exception& e) {
         CPPA_LOG_ERROR(to_verbose_string(e));
+        // drop the partially serialized frame and all aliases
+        // the receiver is never going to see
+        wbuf.erase_trailing(wbuf.size() - before);
+        m_outgoing_addresses.truncate(aliases);
         return;
     }
     CPPA_LOG_DEBUG("serialized: " << to_string(hdr) << " " << to_string(msg));
     size =   static_cast<std::uint32_t>((wbuf.size() - before))
            - static_cast<std::uint32_t>(sizeof(std::uint32_t));
+    if (ctrl == no_control && size > max_chunk_size) {
+        // chunks may arrive after frames written later, i.e., large
+        // messages must not define aliases and are serialized again
+        wbuf.erase_trailing(wbuf.size() - before);
+        m_outgoing_addresses.truncate(aliases);
+        enqueue_chunked(hdr, msg);
+        return;
+    }
+    if (ctrl != no_control) size |= control_frame_flag;
+    else if (compress_frame(wbuf, before + sizeof(uint32_t))) {
+        size =   static_cast<uint32_t>(wbuf.size() - before - sizeof(uint32_t))
+               | compressed_frame_flag;
+    }
+    if (prioritized) size |= unaliased_frame_flag;
     // update size in buffer
     memcpy(wbuf.offset_data(before), &size, sizeof(std::uint32_t));
 }
 
+void peer::enqueue_chunked(msg_hdr_cref hdr, const any_tuple& msg) {
+    outgoing_transfer tr;
+    tr.id = m_next_transfer_id++;
+    tr.sender = hdr.sender;
+    tr.pos = 0;
+    tr.compressed = false;
+    binary_serializer tbs(&tr.data, &(parent()->get_namespace()),
+                          &m_outgoing_types);
+    tbs.compact(m_compact);
+    try {
+        tbs << hdr;
+        write_payload(tbs, tr.data, msg, false);
+    }
+    catch (exception& e) {
+        CPPA_LOG_ERROR(to_verbose_string(e));
+        return;
+    }
+    tr.compressed = compress_frame(tr.data, 0);
+    m_outgoing_transfers.push_back(std::move(tr));
+}
+
+bool peer::compress_frame(util::buffer& buf, size_t offset) {
+    auto threshold = frame_compression_threshold();
+    auto size = buf.size() - offset;
+    if (!m_compression_supported || threshold == 0 || size < threshold) {
+        return false;
+    }
+    auto start = clock_type::now();
+    if (!compression_budget_left(start)) return false;
+    m_compress_buf.clear();
+    util::compress(buf.offset_data(offset), size, m_compress_buf);
+    t_compression_time += (clock_type::now() - start).count();
+    // keep the original unless compressing saves at least 1/16
+    if (m_compress_buf.size() > size - size / 16) return false;
+    buf.erase_trailing(size);
+    buf.write(m_compress_buf);
+    return true;
+}
+
+auto peer::cached(const any_tuple& msg, bool aliased) const
+-> const cached_payload* {
+    if (msg.empty()) return nullptr;
+    auto version = m_outgoing_types.max_id();
+    auto generation = m_outgoing_addresses.generation();
+    for (auto& cp : m_payload_cache) {
+        if (   cp.msg.cvals().get() == msg.cvals().get()
+            && cp.aliased == aliased
+            && cp.type_table_version == version
+            // aliased payloads refer to aliases that might be discarded
+            && (!aliased || cp.alias_generation == generation)) {
+            return &cp;
+        }
+    }
+    return nullptr;
+}
+
+void peer::write_payload(binary_serializer& bs, util::buffer& buf,
+                         const any_tuple& msg, bool aliased) {
+    auto cp = cached(msg, aliased);
+    if (cp) {
+        buf.write(cp->data);
+        return;
+    }
+    auto before = buf.size();
+    auto aliases = m_outgoing_addresses.make_checkpoint();
+    bs << msg;
+    auto now = m_outgoing_addresses.make_checkpoint();
+    if (   msg.empty()
+        || (   aliased
+            && (   aliases.generation != now.generation
+                || aliases.nodes != now.nodes
+                || aliases.actors != now.actors))) {
+        // payloads defining new aliases must not be sent twice
+        return;
+    }
+    auto size = buf.size() - before;
+    // large messages are serialized again without aliases and sent in
+    // chunks, i.e., their aliased payload is never sent
+    if (size > max_cached_payload_size || (aliased && size > max_chunk_size)) {
+        return;
+    }
+    // copy the payload only if the tuple is sent more than once
+    auto tuple = static_cast<const void*>(msg.cvals().get());
+    auto i = find(m_sent_payloads.begin(), m_sent_payloads.end(), tuple);
+    if (i == m_sent_payloads.end()) {
+        if (m_sent_payloads.size() == max_sent_payloads) {
+            m_sent_payloads.pop_front();
+        }
+        m_sent_payloads.push_back(tuple);
+        return;
+    }
+    m_sent_payloads.erase(i);
+    if (m_payload_cache.size() == max_cached_payloads) {
+        m_payload_cache.pop_front();
+    }
+    m_payload_cache.push_back(cached_payload{msg, aliased,
+                                             m_outgoing_types.max_id(),
+                                             now.generation,
+                                             util::buffer{}});
+    m_payload_cache.back().data.write(size, buf.offset_data(before));
+}
+
 void peer::enqueue(msg_hdr_cref hdr, const any_tuple& msg) {
     enqueue_impl(hdr, msg);
     register_for_writing();
@@ -379,8 +1257,12 @@ void peer::enqueue(msg_hdr_cref hdr, const any_tuple& msg) {
 
 void peer::dispose() {
     CPPA_LOG_TRACE(CPPA_ARG(this));
-    parent()->get_namespace().erase(*m_node);
-    parent()->del_peer(this);
+    handshake_done(nullptr, make_exception_ptr(
+        network_error("connection closed during handshake")));
+    if (m_node) {
+        parent()->get_namespace().erase(*m_node);
+        parent()->del_peer(this);
+    }
     delete this;
 }
 
@@ -24,6 +24,8 @@
 #include "cppa/node_id.hpp"
 #include "cppa/to_string.hpp"
 
+#include "cppa/util/buffer.hpp"
+
 #include "cppa/io/peer.hpp"
 #include "cppa/io/peer_acceptor.hpp"
 
@@ -55,29 +57,24 @@ continue_reading_result peer_acceptor::continue_reading() {
             auto& pair = *opt;
             auto& pself = m_parent->node();
             uint32_t process_id = pself->process_id();
-            try {
-                auto& out = pair.second;
-                actor_id aid = published_actor().id();
-                // serialize: actor id, process id, node id, interface
-                out->write(&aid, sizeof(actor_id));
-                out->write(&process_id, sizeof(uint32_t));
-                out->write(pself->host_id().data(),
-                                   pself->host_id().size());
-                auto u32_size = static_cast<std::uint32_t>(m_sigs.size());
-                out->write(&u32_size, sizeof(uint32_t));
-                for (auto& sig : m_sigs) {
-                    u32_size = static_cast<std::uint32_t>(sig.size());
-                    out->write(&u32_size, sizeof(uint32_t));
-                    out->write(sig.c_str(), sig.size());
-                }
-                m_parent->new_peer(pair.first, pair.second);
-            }
-            catch (exception& e) {
-                CPPA_LOG_WARNING("exception while sending actor "
-                                 "and process id: " << to_verbose_string(e));
-                static_cast<void>(e);
-                return continue_reading_result::failure;
+            // serialize: actor id, process id, node id, interface;
+            // the new peer sends this data as soon as the socket
+            // becomes writable, i.e., without blocking the middleman
+            util::buffer buf;
+            actor_id aid = published_actor().id();
+            buf.write(sizeof(actor_id), &aid);
+            buf.write(sizeof(uint32_t), &process_id);
+            buf.write(pself->host_id().size(), pself->host_id().data());
+            auto u32_size = static_cast<std::uint32_t>(m_sigs.size());
+            buf.write(sizeof(uint32_t), &u32_size);
+            for (auto& sig : m_sigs) {
+                u32_size = static_cast<std::uint32_t>(sig.size());
+                buf.write(sizeof(uint32_t), &u32_size);
+                buf.write(sig.size(), sig.c_str());
             }
+            auto p = m_parent->new_peer(pair.first, pair.second);
+            p->write(move(buf));
+            p->send_type_dictionary();
         }
         else return continue_reading_result::continue_later;
    }
@@ -0,0 +1,276 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include <map>
+#include <mutex>
+#include <memory>
+#include <cstring>
+
+#include "cppa/config.hpp"
+#include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
+#include "cppa/singletons.hpp"
+
+#include "cppa/io/resolver.hpp"
+#include "cppa/io/middleman.hpp"
+
+#ifdef CPPA_WINDOWS
+#   include <winsock2.h>
+#   include <ws2tcpip.h>
+#else
+#   include <netdb.h>
+#   include <sys/types.h>
+#   include <sys/socket.h>
+#   include <netinet/in.h>
+#endif
+
+namespace cppa {
+namespace io {
+
+namespace {
+
+typedef std::chrono::steady_clock clock_type;
+
+struct cache_entry {
+    clock_type::time_point expires;
+    socket_address_list addresses;
+};
+
+struct resolver_state {
+    std::mutex mtx;
+    std::map<std::string, cache_entry> cache;
+};
+
+// helper threads own a reference to the state, because they might outlive
+// static objects if the program exits without calling shutdown()
+std::shared_ptr<resolver_state> get_state() {
+    static auto instance = std::make_shared<resolver_state>();
+    return instance;
+}
+
+std::string cache_key(const std::string& host, std::uint16_t port) {
+    return host + ":" + std::to_string(port);
+}
+
+// returns true and sets @p result if the cache has a valid entry for @p key,
+// expects the caller to hold the lock of @p st
+bool cache_lookup(resolver_state& st, const std::string& key,
+                  socket_address_list& result) {
+    auto i = st.cache.find(key);
+    if (i == st.cache.end()) return false;
+    if (i->second.expires <= clock_type::now()) {
+        st.cache.erase(i);
+        return false;
+    }
+    result = i->second.addresses;
+    return true;
+}
+
+// expects the caller to hold the lock of @p st
+void cache_insert(resolver_state& st, const std::string& key,
+                  const socket_address_list& addresses) {
+    auto now = clock_type::now();
+    for (auto i = st.cache.begin(); i != st.cache.end(); ) {
+        if (i->second.expires <= now) i = st.cache.erase(i);
+        else ++i;
+    }
+    st.cache[key] = cache_entry{now + resolver::ttl, addresses};
+}
+
+socket_address_list lookup(const std::string& host, std::uint16_t port) {
+    CPPA_LOGF_TRACE(CPPA_ARG(host) << ", " << CPPA_ARG(port));
+    addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_protocol = IPPROTO_TCP;
+    auto service = std::to_string(port);
+    addrinfo* res = nullptr;
+    auto err = getaddrinfo(host.c_str(), service.c_str(), &hints, &res);
+    if (err != 0) {
+        std::string errstr = "no such host: ";
+        errstr += host;
+        errstr += " (";
+        errstr += gai_strerror(err);
+        errstr += ")";
+        throw network_error(std::move(errstr));
+    }
+    std::unique_ptr<addrinfo, void (*)(addrinfo*)> guard{res, freeaddrinfo};
+    // alternate between address families as described in RFC 6555,
+    // beginning with the family of the first result of getaddrinfo
+    socket_address_list preferred;
+    socket_address_list others;
+    for (auto i = res; i != nullptr; i = i->ai_next) {
+        if (i->ai_family != AF_INET && i->ai_family != AF_INET6) continue;
+        socket_address addr{i->ai_addr, static_cast<size_t>(i->ai_addrlen)};
+        if (i->ai_family == res->ai_family) preferred.push_back(addr);
+        else others.push_back(addr);
+    }
+    socket_address_list result;
+    auto p = preferred.begin();
+    auto o = others.begin();
+    while (p != preferred.end() || o != others.end()) {
+        if (p != preferred.end()) result.push_back(*p++);
+        if (o != others.end()) result.push_back(*o++);
+    }
+    if (result.empty()) {
+        throw network_error("no IPv4 or IPv6 address found for " + host);
+    }
+    CPPA_LOGF_DEBUG("resolved " << host << " to "
+                    << result.size() << " addresses");
+    return result;
+}
+
+} // namespace <anonymous>
+
+socket_address::socket_address(const void* native_addr, size_t size)
+: m_data(static_cast<const char*>(native_addr),
+         static_cast<const char*>(native_addr) + size) { }
+
+int socket_address::family() const {
+    return reinterpret_cast<const sockaddr*>(m_data.data())->sa_family;
+}
+
+bool socket_address::is_loopback() const {
+    if (family() == AF_INET) {
+        auto addr = reinterpret_cast<const sockaddr_in*>(m_data.data());
+        return (ntohl(addr->sin_addr.s_addr) >> 24) == 127;
+    }
+    auto addr = reinterpret_cast<const sockaddr_in6*>(m_data.data());
+    return IN6_IS_ADDR_LOOPBACK(&addr->sin6_addr) != 0;
+}
+
+constexpr std::chrono::seconds resolver::ttl;
+
+constexpr size_t resolver::max_pending_lookups;
+
+resolver::resolver(middleman* parent) : m_parent(parent), m_stopped(false) { }
+
+resolver::~resolver() {
+    stop();
+}
+
+socket_address_list resolver::resolve(const std::string& host,
+                                      std::uint16_t port) {
+#   ifdef CPPA_WINDOWS
+    // make sure TCP has been initialized via WSAStartup
+    cppa::get_middleman();
+#   endif
+    auto st = get_state();
+    auto key = cache_key(host, port);
+    socket_address_list result;
+    { // lifetime scope of guard
+        std::lock_guard<std::mutex> guard{st->mtx};
+        if (cache_lookup(*st, key, result)) return result;
+    }
+    result = lookup(host, port);
+    std::lock_guard<std::mutex> guard{st->mtx};
+    cache_insert(*st, key, result);
+    return result;
+}
+
+void resolver::async_resolve(std::string host,
+                             std::uint16_t port,
+                             resolve_handler hdl) {
+    auto key = cache_key(host, port);
+    socket_address_list cached;
+    { // lifetime scope of guard
+        auto st = get_state();
+        std::lock_guard<std::mutex> guard{st->mtx};
+        if (cache_lookup(*st, key, cached)) {
+            hdl(std::move(cached), nullptr);
+            return;
+        }
+    }
+    auto i = m_pending.find(key);
+    if (i != m_pending.end()) {
+        // the helper thread is already resolving this host
+        i->second.push_back(std::move(hdl));
+        return;
+    }
+    if (m_pending.size() >= max_pending_lookups) {
+        CPPA_LOG_WARNING("too many pending lookups, cannot resolve " << host);
+        hdl(socket_address_list{}, std::make_exception_ptr(
+            network_error("too many pending lookups")));
+        return;
+    }
+    m_pending[key].push_back(std::move(hdl));
+    std::lock_guard<std::mutex> guard{m_mtx};
+    if (m_stopped) return;
+    m_queue.emplace_back(std::move(host), port);
+    if (!m_thread.joinable()) m_thread = std::thread([this] { run(); });
+    else m_cv.notify_one();
+}
+
+void resolver::stop() {
+    { // lifetime scope of guard
+        std::lock_guard<std::mutex> guard{m_mtx};
+        m_stopped = true;
+        m_queue.clear();
+    }
+    m_cv.notify_one();
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void resolver::run() {
+    CPPA_LOG_TRACE("");
+    auto st = get_state();
+    std::unique_lock<std::mutex> guard{m_mtx};
+    for (;;) {
+        m_cv.wait(guard, [&] { return m_stopped || !m_queue.empty(); });
+        if (m_stopped) return;
+        auto host = std::move(m_queue.front().first);
+        auto port = m_queue.front().second;
+        m_queue.pop_front();
+        guard.unlock();
+        auto key = cache_key(host, port);
+        socket_address_list addresses;
+        std::exception_ptr eptr;
+        try { addresses = lookup(host, port); }
+        catch (...) { eptr = std::current_exception(); }
+        if (!eptr) {
+            std::lock_guard<std::mutex> cache_guard{st->mtx};
+            cache_insert(*st, key, addresses);
+        }
+        // the middleman waits for this thread in stop() before
+        // its event loop terminates, i.e., m_parent is valid
+        m_parent->run_later([=] { deliver(key, addresses, eptr); });
+        guard.lock();
+    }
+}
+
+void resolver::deliver(const std::string& key,
+                       const socket_address_list& addresses,
+                       std::exception_ptr eptr) {
+    auto i = m_pending.find(key);
+    if (i == m_pending.end()) return;
+    std::vector<resolve_handler> handlers;
+    handlers.swap(i->second);
+    m_pending.erase(i);
+    for (auto& f : handlers) f(addresses, eptr);
+}
+
+void resolver::clear_cache() {
+    auto st = get_state();
+    std::lock_guard<std::mutex> guard{st->mtx};
+    st->cache.clear();
+}
+
+} // namespace io
+} // namespace cppa
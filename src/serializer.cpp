@@ -17,13 +17,52 @@
 \******************************************************************************/
 
 
+#include <cstdint>
+#include <stdexcept>
+
 #include "cppa/serializer.hpp"
+#include "cppa/primitive_variant.hpp"
 
 namespace cppa {
 
-serializer::serializer(actor_namespace* ns, type_lookup_table* it)
-: m_namespace{ns}, m_outgoing_types{it} { }
+namespace {
+
+template<typename T>
+void write_each(serializer* sink, size_t num, const void* values) {
+    auto first = static_cast<const T*>(values);
+    for (auto i = first; i != first + num; ++i) {
+        sink->write_value(*i);
+    }
+}
+
+} // namespace <anonymous>
+
+serializer::serializer(actor_namespace* ns, type_lookup_table* it,
+                       address_lookup_table* at)
+: m_namespace{ns}, m_outgoing_types{it}, m_outgoing_addresses{at} { }
 
 serializer::~serializer() { }
 
+bool serializer::native_layout() const {
+    return false;
+}
+
+void serializer::write_values(primitive_type ptype, size_t num,
+                              const void* values) {
+    switch (ptype) {
+        case pt_int8:   write_each<std::int8_t>(this, num, values);   break;
+        case pt_int16:  write_each<std::int16_t>(this, num, values);  break;
+        case pt_int32:  write_each<std::int32_t>(this, num, values);  break;
+        case pt_int64:  write_each<std::int64_t>(this, num, values);  break;
+        case pt_uint8:  write_each<std::uint8_t>(this, num, values);  break;
+        case pt_uint16: write_each<std::uint16_t>(this, num, values); break;
+        case pt_uint32: write_each<std::uint32_t>(this, num, values); break;
+        case pt_uint64: write_each<std::uint64_t>(this, num, values); break;
+        case pt_float:  write_each<float>(this, num, values);          break;
+        case pt_double: write_each<double>(this, num, values);        break;
+        default: throw std::invalid_argument("write_values: "
+                                             "not an arithmetic type");
+    }
+}
+
 } // namespace cppa
@@ -0,0 +1,93 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include "cppa/config.hpp"
+
+#ifdef CPPA_LINUX
+
+#include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
+
+#include "cppa/io/stream.hpp"
+#include "cppa/io/shm_acceptor.hpp"
+#include "cppa/io/shm_io_stream.hpp"
+#include "cppa/io/unix_acceptor.hpp"
+
+namespace cppa {
+namespace io {
+
+namespace {
+
+stream_ptr_pair to_shm_pair(const stream_ptr_pair& channel) {
+    // both members of the pair refer to the same Unix domain socket
+    stream_ptr ptr{dynamic_cast<stream*>(channel.first.get())};
+    auto result = shm_io_stream::accept_from(std::move(ptr));
+    return {result, result};
+}
+
+} // namespace <anonymous>
+
+std::string shm_acceptor::endpoint(const node_id& node, actor_id aid) {
+    // a leading null byte selects the abstract namespace, i.e.,
+    // the socket disappears along with the process
+    std::string result(1, '\0');
+    result += "cppa_shm_";
+    result += to_string(node);
+    result += "_";
+    result += std::to_string(aid);
+    return result;
+}
+
+std::unique_ptr<acceptor> shm_acceptor::create(const std::string& path) {
+    std::unique_ptr<acceptor> channel_acceptor{unix_acceptor::create(path)};
+    return std::unique_ptr<acceptor>{
+               new shm_acceptor(std::move(channel_acceptor))};
+}
+
+shm_acceptor::shm_acceptor(std::unique_ptr<acceptor> channel_acceptor)
+: m_channel_acceptor(std::move(channel_acceptor)) { }
+
+shm_acceptor::~shm_acceptor() { }
+
+native_socket_type shm_acceptor::file_handle() const {
+    return m_channel_acceptor->file_handle();
+}
+
+stream_ptr_pair shm_acceptor::accept_connection() {
+    return to_shm_pair(m_channel_acceptor->accept_connection());
+}
+
+optional<stream_ptr_pair> shm_acceptor::try_accept_connection() {
+    for (;;) {
+        auto channel = m_channel_acceptor->try_accept_connection();
+        if (!channel) return none;
+        // a client that disconnects early, e.g., unix_acceptor::create
+        // probing for a running process, must not stop this acceptor
+        try { return to_shm_pair(*channel); }
+        catch (network_error& e) {
+            CPPA_LOG_INFO("dropped shared memory connection: " << e.what());
+            static_cast<void>(e); // keep compiler happy
+        }
+    }
+}
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_LINUX
@@ -0,0 +1,411 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include "cppa/config.hpp"
+
+#ifdef CPPA_LINUX
+
+#include <atomic>
+#include <cstring>
+#include <errno.h>
+#include <algorithm>
+
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+
+#include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
+
+#include "cppa/io/middleman.hpp"
+#include "cppa/io/continuable.hpp"
+#include "cppa/io/shm_io_stream.hpp"
+#include "cppa/io/unix_io_stream.hpp"
+
+#include "cppa/detail/fd_util.hpp"
+
+#ifndef MFD_CLOEXEC
+#   define MFD_CLOEXEC 0x0001U
+#endif
+
+namespace cppa {
+namespace io {
+
+using namespace ::cppa::detail::fd_util;
+
+/**
+ * @brief Shared state of a single-producer, single-consumer ring buffer.
+ *        The data of the ring buffer directly follows this header.
+ */
+struct shm_ring {
+    // total number of bytes written by the producer
+    alignas(64) std::atomic<std::uint64_t> head;
+    // total number of bytes read by the consumer
+    alignas(64) std::atomic<std::uint64_t> tail;
+    // set by the consumer before waiting for a wakeup via the channel
+    alignas(64) std::atomic<std::uint32_t> consumer_sleeping;
+    // set by the producer before waiting for its eventfd
+    std::atomic<std::uint32_t> producer_sleeping;
+};
+
+namespace {
+
+// capacity of each ring buffer, must be a power of two
+constexpr size_t ring_capacity = 1024 * 1024;
+
+// the header of each ring occupies a page of its own
+constexpr size_t ring_header_size = 4096;
+
+constexpr size_t ring_size = ring_header_size + ring_capacity;
+
+// the eventfd of a producer is "not writable" while its counter has
+// this value, i.e., the producer waits for write events on the eventfd
+// and the consumer unblocks it by reading (resetting) the counter
+constexpr std::uint64_t eventfd_blocked = 0xfffffffffffffffeULL;
+
+inline char* ring_data(shm_ring* ring) {
+    return reinterpret_cast<char*>(ring) + ring_header_size;
+}
+
+inline shm_ring* ring_at(void* mem, size_t index) {
+    return reinterpret_cast<shm_ring*>(static_cast<char*>(mem)
+                                       + index * ring_size);
+}
+
+void reset_eventfd(int efd) {
+    std::uint64_t value;
+    if (::read(efd, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+        throw_io_failure("cannot read from eventfd");
+    }
+}
+
+void block_eventfd(int efd) {
+    auto value = eventfd_blocked;
+    // EAGAIN: counter is already blocked and a reset is pending
+    if (::write(efd, &value, sizeof(value)) < 0 && errno != EAGAIN) {
+        throw_io_failure("cannot write to eventfd");
+    }
+}
+
+void* map_shared(int memfd) {
+    auto res = mmap(nullptr, 2 * ring_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED, memfd, 0);
+    if (res == MAP_FAILED) throw_io_failure("mmap() failed");
+    return res;
+}
+
+void await(native_socket_type fd, short events) {
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = events;
+    pfd.revents = 0;
+    while (::poll(&pfd, 1, -1) < 0) {
+        if (errno != EINTR) throw_io_failure("poll() failed");
+    }
+}
+
+// waits until the channel of a new connection received the shared memory
+class shm_connector : public continuable {
+
+ public:
+
+    shm_connector(middleman* parent, stream_ptr channel, connect_handler hdl)
+    : continuable(channel->read_handle()), m_parent(parent)
+    , m_channel(std::move(channel)), m_hdl(std::move(hdl)) { }
+
+    continue_reading_result continue_reading() override {
+        stream_ptr result;
+        try { result = shm_io_stream::try_connect(m_channel); }
+        catch (std::exception&) {
+            done(nullptr, std::current_exception());
+            return continue_reading_result::failure;
+        }
+        if (!result) return continue_reading_result::continue_later;
+        done(std::move(result), nullptr);
+        return continue_reading_result::closed;
+    }
+
+    void io_failed(event_bitmask) override {
+        done(nullptr, std::make_exception_ptr(
+            network_error("cannot receive shared memory handles")));
+    }
+
+    void dispose() override {
+        delete this;
+    }
+
+ private:
+
+    void done(stream_ptr ptr, std::exception_ptr eptr) {
+        if (!m_hdl) return;
+        auto hdl = std::move(m_hdl);
+        m_hdl = nullptr;
+        // the new stream reads from the channel as well, i.e., it must
+        // not be handed over before the middleman removed this connector
+        m_parent->run_later([hdl, ptr, eptr] { hdl(ptr, eptr); });
+    }
+
+    middleman* m_parent;
+    stream_ptr m_channel;
+    connect_handler m_hdl;
+
+};
+
+} // namespace <anonymous>
+
+shm_io_stream::shm_io_stream(stream_ptr channel, void* mem,
+                             int tx_efd, int rx_efd, bool is_server)
+: m_channel(std::move(channel)), m_mem(mem)
+, m_tx_efd(tx_efd), m_rx_efd(rx_efd)
+, m_tx(ring_at(mem, is_server ? 0 : 1))
+, m_rx(ring_at(mem, is_server ? 1 : 0)), m_channel_closed(false) { }
+
+shm_io_stream::~shm_io_stream() {
+    munmap(m_mem, 2 * ring_size);
+    close(m_tx_efd);
+    close(m_rx_efd);
+}
+
+stream_ptr shm_io_stream::accept_from(stream_ptr channel) {
+    CPPA_LOGF_TRACE("");
+    int fds[3] = {-1, -1, -1};
+    auto close_fds = [&] {
+        for (auto fd : fds) if (fd != -1) close(fd);
+    };
+    void* mem = nullptr;
+    try {
+        fds[0] = static_cast<int>(syscall(SYS_memfd_create, "cppa_shm_stream",
+                                          MFD_CLOEXEC));
+        if (fds[0] < 0) throw_io_failure("memfd_create() failed");
+        if (ftruncate(fds[0], static_cast<off_t>(2 * ring_size)) != 0) {
+            throw_io_failure("ftruncate() failed");
+        }
+        // fds[1] signals free space in ring 0 (server to client),
+        // fds[2] signals free space in ring 1 (client to server)
+        for (int i = 1; i < 3; ++i) {
+            fds[i] = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+            if (fds[i] < 0) throw_io_failure("eventfd() failed");
+        }
+        mem = map_shared(fds[0]);
+        // both consumers start sleeping, i.e., the first write
+        // into a ring buffer always sends a wakeup
+        for (size_t i = 0; i < 2; ++i) {
+            auto ring = new (ring_at(mem, i)) shm_ring();
+            ring->consumer_sleeping.store(1);
+        }
+        char dummy = 0;
+        iovec iov;
+        iov.iov_base = &dummy;
+        iov.iov_len = 1;
+        char ctrl[CMSG_SPACE(sizeof(fds))];
+        memset(ctrl, 0, sizeof(ctrl));
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+        auto cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+        memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+        auto sockfd = channel->write_handle();
+        ssize_t res;
+        while ((res = sendmsg(sockfd, &msg, MSG_NOSIGNAL)) < 0
+               && errno == EAGAIN) {
+            await(sockfd, POLLOUT);
+        }
+        if (res != 1) throw_io_failure("cannot send shared memory handles");
+    }
+    catch (...) {
+        if (mem) munmap(mem, 2 * ring_size);
+        close_fds();
+        throw;
+    }
+    close(fds[0]);
+    return new shm_io_stream(std::move(channel), mem, fds[1], fds[2], true);
+}
+
+stream_ptr shm_io_stream::connect_to(const std::string& path) {
+    CPPA_LOGF_TRACE(CPPA_ARG(path));
+    auto channel = unix_io_stream::connect_to(path);
+    for (;;) {
+        auto result = try_connect(channel);
+        if (result) return result;
+        await(channel->read_handle(), POLLIN);
+    }
+}
+
+stream_ptr shm_io_stream::try_connect(const stream_ptr& channel) {
+    CPPA_LOGF_TRACE("");
+    int fds[3];
+    char dummy;
+    iovec iov;
+    iov.iov_base = &dummy;
+    iov.iov_len = 1;
+    char ctrl[CMSG_SPACE(sizeof(fds))];
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = ctrl;
+    msg.msg_controllen = sizeof(ctrl);
+    auto res = recvmsg(channel->read_handle(), &msg, MSG_CMSG_CLOEXEC);
+    if (res < 0 && (errno == EAGAIN || errno == EINTR)) return nullptr;
+    auto cmsg = CMSG_FIRSTHDR(&msg);
+    if (res != 1 || cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS
+            || cmsg->cmsg_len != CMSG_LEN(sizeof(fds))) {
+        throw network_error("cannot receive shared memory handles");
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+    void* mem;
+    try { mem = map_shared(fds[0]); }
+    catch (...) {
+        for (auto fd : fds) close(fd);
+        throw;
+    }
+    close(fds[0]);
+    return new shm_io_stream(channel, mem, fds[2], fds[1], false);
+}
+
+void shm_io_stream::async_connect(middleman* parent, stream_ptr channel,
+                                  connect_handler hdl) {
+    CPPA_LOGF_TRACE("");
+    parent->continue_reader(new shm_connector(parent, std::move(channel),
+                                              std::move(hdl)));
+}
+
+native_socket_type shm_io_stream::read_handle() const {
+    return m_channel->read_handle();
+}
+
+native_socket_type shm_io_stream::write_handle() const {
+    return m_tx_efd;
+}
+
+void shm_io_stream::drain_channel() {
+    char buf[64];
+    try {
+        while (m_channel->read_some(buf, sizeof(buf)) == sizeof(buf)) {
+            // read until the channel has no more notifications
+        }
+    }
+    catch (std::exception&) {
+        // the other process closed the connection
+        m_channel_closed = true;
+    }
+}
+
+size_t shm_io_stream::read_some(void* vbuf, size_t len) {
+    if (!m_channel_closed) drain_channel();
+    auto buf = static_cast<char*>(vbuf);
+    auto tail = m_rx->tail.load(std::memory_order_relaxed);
+    size_t rd = 0;
+    // callers assume that no more data is available if we return less
+    // than @p len bytes, i.e., we either fill the buffer or announce
+    // that we're going to sleep while the ring buffer is empty
+    while (rd < len) {
+        auto available = m_rx->head.load(std::memory_order_acquire) - tail;
+        if (available == 0) {
+            // announce that we're going to sleep before checking again,
+            // otherwise we might miss a wakeup
+            m_rx->consumer_sleeping.store(1);
+            available = m_rx->head.load() - tail;
+            if (available == 0) break;
+            m_rx->consumer_sleeping.store(0);
+        }
+        auto n = std::min(len - rd, static_cast<size_t>(available));
+        auto pos = static_cast<size_t>(tail) & (ring_capacity - 1);
+        auto first = std::min(n, ring_capacity - pos);
+        memcpy(buf + rd, ring_data(m_rx) + pos, first);
+        memcpy(buf + rd + first, ring_data(m_rx), n - first);
+        tail += n;
+        rd += n;
+        m_rx->tail.store(tail, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_rx->producer_sleeping.load() != 0
+                && m_rx->producer_sleeping.exchange(0) != 0) {
+            reset_eventfd(m_rx_efd);
+        }
+    }
+    if (rd == 0 && len > 0 && m_channel_closed) {
+        throw stream_at_eof("cannot read from closed connection");
+    }
+    return rd;
+}
+
+size_t shm_io_stream::write_some(const void* buf, size_t len) {
+    auto head = m_tx->head.load(std::memory_order_relaxed);
+    auto free_space = ring_capacity
+                      - (head - m_tx->tail.load(std::memory_order_acquire));
+    if (free_space == 0) {
+        // block our eventfd and announce that we're going to sleep
+        // before checking again, otherwise we might miss a wakeup
+        block_eventfd(m_tx_efd);
+        m_tx->producer_sleeping.store(1);
+        free_space = ring_capacity - (head - m_tx->tail.load());
+        if (free_space == 0) return 0;
+        if (m_tx->producer_sleeping.exchange(0) != 0) reset_eventfd(m_tx_efd);
+    }
+    auto n = std::min(len, static_cast<size_t>(free_space));
+    auto pos = static_cast<size_t>(head) & (ring_capacity - 1);
+    auto first = std::min(n, ring_capacity - pos);
+    auto in = static_cast<const char*>(buf);
+    memcpy(ring_data(m_tx) + pos, in, first);
+    memcpy(ring_data(m_tx), in + first, n - first);
+    m_tx->head.store(head + n, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_tx->consumer_sleeping.load() != 0
+            && m_tx->consumer_sleeping.exchange(0) != 0) {
+        char wakeup = 0;
+        // errors are ignored: a full channel already contains a pending
+        // wakeup and a closed channel is detected when reading from it
+        ::send(m_channel->write_handle(), &wakeup, 1, MSG_NOSIGNAL);
+    }
+    return n;
+}
+
+void shm_io_stream::read(void* vbuf, size_t len) {
+    auto buf = static_cast<char*>(vbuf);
+    size_t rd = 0;
+    while (rd < len) {
+        auto n = read_some(buf + rd, len - rd);
+        if (n == 0) await(read_handle(), POLLIN);
+        rd += n;
+    }
+}
+
+void shm_io_stream::write(const void* vbuf, size_t len) {
+    auto buf = static_cast<const char*>(vbuf);
+    size_t written = 0;
+    while (written < len) {
+        auto n = write_some(buf + written, len - written);
+        if (n == 0) await(write_handle(), POLLOUT);
+        written += n;
+    }
+}
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_LINUX
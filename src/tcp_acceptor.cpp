@@ -72,10 +72,10 @@ struct socket_guard {
 bool accept_impl(stream_ptr_pair& result,
                  native_socket_type fd,
                  bool nonblocking) {
-    sockaddr addr;
+    sockaddr_storage addr;
     memset(&addr, 0, sizeof(addr));
     socklen_t addrlen = sizeof(addr);
-    auto sfd = ::accept(fd, &addr, &addrlen);
+    auto sfd = ::accept(fd, reinterpret_cast<sockaddr*>(&addr), &addrlen);
     if (sfd == invalid_socket) {
         auto err = last_socket_error();
         CPPA_LOGF_DEBUG("accept failed for reason " << err);
@@ -104,7 +104,37 @@ std::unique_ptr<acceptor> tcp_acceptor::create(std::uint16_t port,
     // ensure that TCP has been initialized via WSAStartup
     cppa::get_middleman();
 #   endif
-    native_socket_type sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in serv_addr;
+    sockaddr_in6 serv_addr6;
+    memset(&serv_addr, 0, sizeof(serv_addr));
+    memset(&serv_addr6, 0, sizeof(serv_addr6));
+    serv_addr.sin_family = AF_INET;
+    serv_addr.sin_port = htons(port);
+    serv_addr6.sin6_family = AF_INET6;
+    serv_addr6.sin6_port = htons(port);
+    bool use_ipv6;
+    if (! addr) {
+        // listen on all IPv6 and IPv4 interfaces if possible
+        serv_addr.sin_addr.s_addr = INADDR_ANY;
+        serv_addr6.sin6_addr = in6addr_any;
+        use_ipv6 = true;
+    }
+    else if (::inet_pton(AF_INET, addr, &serv_addr.sin_addr) > 0) {
+        use_ipv6 = false;
+    }
+    else if (::inet_pton(AF_INET6, addr, &serv_addr6.sin6_addr) > 0) {
+        use_ipv6 = true;
+    }
+    else {
+        throw network_error("invalid IPv4 or IPv6 address");
+    }
+    native_socket_type sockfd = socket(use_ipv6 ? AF_INET6 : AF_INET,
+                                       SOCK_STREAM, 0);
+    if (sockfd == invalid_socket && ! addr) {
+        // IPv6 is not available on this host
+        use_ipv6 = false;
+        sockfd = socket(AF_INET, SOCK_STREAM, 0);
+    }
     if (sockfd == invalid_socket) {
         throw network_error("could not create server socket");
     }
@@ -115,17 +145,23 @@ std::unique_ptr<acceptor> tcp_acceptor::create(std::uint16_t port,
                    reinterpret_cast<setsockopt_ptr>(&on), sizeof(on)) < 0) {
         throw_io_failure("unable to set SO_REUSEADDR");
     }
-    struct sockaddr_in serv_addr;
-    memset((char*) &serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    if (! addr) {
-        serv_addr.sin_addr.s_addr = INADDR_ANY;
+    int bind_result;
+    if (use_ipv6) {
+        if (! addr) {
+            // accept IPv4 connections as well (dual-stack socket)
+            int off = 0;
+            if (setsockopt(sockfd, IPPROTO_IPV6, IPV6_V6ONLY,
+                           reinterpret_cast<setsockopt_ptr>(&off),
+                           sizeof(off)) < 0) {
+                throw_io_failure("unable to unset IPV6_V6ONLY");
+            }
+        }
+        bind_result = bind(sockfd, (sockaddr*) &serv_addr6, sizeof(serv_addr6));
     }
-    else if (::inet_pton(AF_INET, addr, &serv_addr.sin_addr) <= 0) {
-        throw network_error("invalid IPv4 address");
+    else {
+        bind_result = bind(sockfd, (sockaddr*) &serv_addr, sizeof(serv_addr));
     }
-    serv_addr.sin_port = htons(port);
-    if (bind(sockfd, (sockaddr*) &serv_addr, sizeof(serv_addr)) < 0) {
+    if (bind_result < 0) {
         throw bind_failure(errno);
     }
     if (listen(sockfd, SOMAXCONN) != 0) {
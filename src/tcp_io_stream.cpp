@@ -17,14 +17,22 @@
 \******************************************************************************/
 
 
+#include <chrono>
+#include <vector>
 #include <cstring>
+#include <algorithm>
 #include <errno.h>
 #include <iostream>
 
 #include "cppa/config.hpp"
 #include "cppa/logging.hpp"
 #include "cppa/exception.hpp"
+#include "cppa/ref_counted.hpp"
+#include "cppa/intrusive_ptr.hpp"
 #include "cppa/detail/fd_util.hpp"
+#include "cppa/io/resolver.hpp"
+#include "cppa/io/middleman.hpp"
+#include "cppa/io/continuable.hpp"
 #include "cppa/io/tcp_io_stream.hpp"
 
 #ifdef CPPA_WINDOWS
@@ -32,8 +40,10 @@
 #   include <winsock2.h>
 #else
 #   include <netdb.h>
+#   include <poll.h>
 #   include <unistd.h>
 #   include <sys/types.h>
+#   include <sys/uio.h>
 #   include <sys/socket.h>
 #   include <netinet/in.h>
 #   include <netinet/tcp.h>
@@ -44,6 +54,18 @@ namespace io {
 
 using namespace ::cppa::detail::fd_util;
 
+namespace {
+
+// writing to a connection the other side closed must not raise
+// SIGPIPE, the error returned by send() suffices to drop the peer
+#ifdef MSG_NOSIGNAL
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+
+} // namespace <anonymous>
+
 tcp_io_stream::tcp_io_stream(native_socket_type fd) : m_fd(fd) {
     CPPA_LOG_TRACE("new IO stream using socket " << fd);
 }
@@ -91,7 +113,8 @@ void tcp_io_stream::write(const void* vbuf, size_t len) {
     auto buf = reinterpret_cast<const char*>(vbuf);
     size_t written = 0;
     while (written < len) {
-        auto send_result = ::send(m_fd, buf + written, len - written, 0);
+        auto send_result = ::send(m_fd, buf + written, len - written,
+                                  send_flags);
         handle_write_result(send_result, true);
         if (send_result > 0) {
             written += static_cast<size_t>(send_result);
@@ -110,9 +133,33 @@ void tcp_io_stream::write(const void* vbuf, size_t len) {
 
 size_t tcp_io_stream::write_some(const void* buf, size_t len) {
     CPPA_LOG_TRACE(CPPA_ARG(buf) << ", " << CPPA_ARG(len));
-    auto send_result = ::send(m_fd, reinterpret_cast<const char*>(buf), len, 0);
+    auto send_result = ::send(m_fd, reinterpret_cast<const char*>(buf), len,
+                              send_flags);
     handle_write_result(send_result, true);
-    return static_cast<size_t>(send_result);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
+}
+
+size_t tcp_io_stream::write_some_vec(const io_slice* slices,
+                                     size_t num_slices) {
+#   ifdef CPPA_WINDOWS
+    return output_stream::write_some_vec(slices, num_slices);
+#   else
+    CPPA_LOG_TRACE(CPPA_ARG(num_slices));
+    static constexpr size_t max_iovecs = 64;
+    iovec iov[max_iovecs];
+    auto n = std::min(num_slices, max_iovecs);
+    for (size_t i = 0; i < n; ++i) {
+        iov[i].iov_base = const_cast<void*>(slices[i].data);
+        iov[i].iov_len = slices[i].size;
+    }
+    msghdr msg;
+    memset(&msg, 0, sizeof(msghdr));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = n;
+    auto send_result = ::sendmsg(m_fd, &msg, send_flags);
+    handle_write_result(send_result, true);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
+#   endif
 }
 
 io::stream_ptr tcp_io_stream::from_sockfd(native_socket_type fd) {
@@ -121,42 +168,305 @@ io::stream_ptr tcp_io_stream::from_sockfd(native_socket_type fd) {
     return new tcp_io_stream(fd);
 }
 
+namespace {
+
+// delay between two connection attempts as recommended by RFC 6555
+constexpr int connection_attempt_delay_ms = 250;
+
+// creates a nonblocking socket for @p addr and calls connect(); returns
+// invalid_socket if connect() fails immediately and sets @p connected
+// to true if connect() succeeds immediately
+native_socket_type start_connection(const socket_address& addr,
+                                    bool& connected) {
+    auto fd = socket(addr.family(), SOCK_STREAM, 0);
+    if (fd == invalid_socket) return invalid_socket;
+    try { nonblocking(fd, true); }
+    catch (std::exception&) {
+        closesocket(fd);
+        return invalid_socket;
+    }
+    auto sa = reinterpret_cast<const sockaddr*>(addr.data());
+    connected = connect(fd, sa, static_cast<socklen_t>(addr.size())) == 0;
+    if (!connected) {
+        auto err = last_socket_error();
+#       ifdef CPPA_WINDOWS
+        auto in_progress = err == WSAEWOULDBLOCK;
+#       else
+        auto in_progress = err == EINPROGRESS;
+#       endif
+        if (!in_progress) {
+            CPPA_LOGF_DEBUG("connect() failed: " << err);
+            closesocket(fd);
+            return invalid_socket;
+        }
+    }
+    return fd;
+}
+
+#ifdef CPPA_WINDOWS
+
+// connects to the first reachable address in @p addrs by trying one
+// address after another, overlapping attempts are only supported on POSIX
+native_socket_type connect_any(const socket_address_list& addrs) {
+    for (auto& addr : addrs) {
+        auto fd = socket(addr.family(), SOCK_STREAM, 0);
+        if (fd == invalid_socket) continue;
+        auto sa = reinterpret_cast<const sockaddr*>(addr.data());
+        if (connect(fd, sa, static_cast<socklen_t>(addr.size())) == 0) {
+            return fd;
+        }
+        CPPA_LOGF_DEBUG("connect() failed: " << last_socket_error());
+        closesocket(fd);
+    }
+    throw network_error("could not connect to host");
+}
+
+#else // CPPA_WINDOWS
+
+// connects to the first reachable address in @p addrs ("happy eyeballs");
+// a new attempt is started whenever no attempt has succeeded within
+// connection_attempt_delay_ms, earlier attempts remain active
+native_socket_type connect_any(const socket_address_list& addrs) {
+    std::vector<pollfd> attempts;
+    auto close_attempts = [&] {
+        for (auto& pfd : attempts) closesocket(pfd.fd);
+    };
+    size_t next = 0;
+    for (;;) {
+        if (next < addrs.size()) {
+            bool connected = false;
+            auto fd = start_connection(addrs[next++], connected);
+            if (connected) {
+                close_attempts();
+                return fd;
+            }
+            if (fd != invalid_socket) {
+                pollfd pfd;
+                pfd.fd = fd;
+                pfd.events = POLLOUT;
+                pfd.revents = 0;
+                attempts.push_back(pfd);
+            }
+            // try next address without delay
+            else if (next < addrs.size()) continue;
+        }
+        if (attempts.empty()) {
+            throw network_error("could not connect to host");
+        }
+        auto timeout = next < addrs.size() ? connection_attempt_delay_ms : -1;
+        auto presult = ::poll(attempts.data(),
+                              static_cast<nfds_t>(attempts.size()),
+                              timeout);
+        if (presult < 0) {
+            if (last_socket_error() == EINTR) continue;
+            close_attempts();
+            throw_io_failure("poll() failed");
+        }
+        for (auto i = attempts.begin(); i != attempts.end(); ) {
+            if (i->revents == 0) {
+                ++i;
+                continue;
+            }
+            int err = 0;
+            socklen_t errlen = sizeof(err);
+            if (getsockopt(i->fd, SOL_SOCKET, SO_ERROR,
+                           reinterpret_cast<char*>(&err), &errlen) == 0
+                    && err == 0) {
+                auto fd = i->fd;
+                attempts.erase(i);
+                close_attempts();
+                return fd;
+            }
+            CPPA_LOGF_DEBUG("connection attempt failed: " << err);
+            closesocket(i->fd);
+            i = attempts.erase(i);
+        }
+    }
+}
+
+#endif // CPPA_WINDOWS
+
+class connect_attempt;
+
+// state of an asynchronous connect, i.e., of all connection attempts
+// to the addresses of one host; lives in the event loop of the middleman
+class async_connect_state : public ref_counted {
+
+ public:
+
+    async_connect_state(middleman* parent, socket_address_list addrs,
+                        connect_handler hdl)
+    : m_parent(parent), m_addrs(std::move(addrs)), m_next(0)
+    , m_hdl(std::move(hdl)) { }
+
+    // starts attempts until one is pending or no address is left
+    void start_next();
+
+    // called by a pending attempt once its connect() has finished
+    void attempt_done(connect_attempt* ptr, native_socket_type fd);
+
+ private:
+
+    // starts the next attempt after connection_attempt_delay_ms
+    // unless another attempt was started in the meantime
+    void schedule_next();
+
+    void done(native_socket_type fd);
+
+    middleman* m_parent;
+    socket_address_list m_addrs;
+    size_t m_next;
+    // empty once a connection has been established or all attempts failed
+    connect_handler m_hdl;
+    std::vector<connect_attempt*> m_attempts;
+
+};
+
+typedef intrusive_ptr<async_connect_state> async_connect_state_ptr;
+
+// waits for a nonblocking connect() to finish, i.e.,
+// for its socket to become writable
+class connect_attempt : public continuable {
+
+ public:
+
+    connect_attempt(async_connect_state_ptr state, native_socket_type fd)
+    : continuable(invalid_socket, fd), m_state(std::move(state)), m_fd(fd) { }
+
+    continue_writing_result continue_writing() override {
+        int err = 0;
+        socklen_t errlen = sizeof(err);
+        if (getsockopt(m_fd, SOL_SOCKET, SO_ERROR,
+                       reinterpret_cast<char*>(&err), &errlen) != 0) {
+            err = last_socket_error();
+        }
+        if (err == 0) {
+            // the state owns the socket from now on
+            auto fd = m_fd;
+            m_fd = invalid_socket;
+            m_state->attempt_done(this, fd);
+        }
+        else {
+            CPPA_LOG_DEBUG("connection attempt failed: " << err);
+            m_state->attempt_done(this, invalid_socket);
+        }
+        return continue_writing_result::done;
+    }
+
+    void io_failed(event_bitmask mask) override {
+        if (mask == event::write) {
+            m_state->attempt_done(this, invalid_socket);
+        }
+    }
+
+    void dispose() override {
+        if (m_fd != invalid_socket) closesocket(m_fd);
+        delete this;
+    }
+
+ private:
+
+    async_connect_state_ptr m_state;
+    native_socket_type m_fd;
+
+};
+
+void async_connect_state::start_next() {
+    while (m_hdl && m_next < m_addrs.size()) {
+        bool connected = false;
+        auto fd = start_connection(m_addrs[m_next++], connected);
+        if (connected) {
+            done(fd);
+            return;
+        }
+        if (fd != invalid_socket) {
+            auto ptr = new connect_attempt(this, fd);
+            m_attempts.push_back(ptr);
+            m_parent->continue_connecting(ptr);
+            if (m_next < m_addrs.size()) schedule_next();
+            return;
+        }
+    }
+    if (m_hdl && m_attempts.empty()) done(invalid_socket);
+}
+
+void async_connect_state::attempt_done(connect_attempt* ptr,
+                                       native_socket_type fd) {
+    auto i = std::find(m_attempts.begin(), m_attempts.end(), ptr);
+    if (i == m_attempts.end()) {
+        // attempt has been stopped
+        if (fd != invalid_socket) closesocket(fd);
+        return;
+    }
+    m_attempts.erase(i);
+    if (fd != invalid_socket) done(fd);
+    // fail over to the next address without waiting
+    else start_next();
+}
+
+void async_connect_state::schedule_next() {
+    async_connect_state_ptr self{this};
+    auto next = m_next;
+    std::chrono::milliseconds delay{connection_attempt_delay_ms};
+    m_parent->run_delayed(delay, [self, next] {
+        if (self->m_next == next) self->start_next();
+    });
+}
+
+void async_connect_state::done(native_socket_type fd) {
+    // stop remaining attempts, the middleman closes their sockets
+    auto attempts = std::move(m_attempts);
+    m_attempts.clear();
+    for (auto ptr : attempts) m_parent->stop_writer(ptr);
+    auto hdl = std::move(m_hdl);
+    m_hdl = nullptr;
+    // the successful attempt is still registered for its socket until
+    // the middleman updated its event handler, i.e., the socket must
+    // not be handed over before the next iteration of the event loop
+    m_parent->run_later([hdl, fd] {
+        if (fd == invalid_socket) {
+            hdl(nullptr, std::make_exception_ptr(
+                network_error("could not connect to host")));
+            return;
+        }
+        stream_ptr ptr;
+        try { ptr = tcp_io_stream::from_sockfd(fd); }
+        catch (...) {
+            closesocket(fd);
+            hdl(nullptr, std::current_exception());
+            return;
+        }
+        hdl(std::move(ptr), nullptr);
+    });
+}
+
+} // namespace <anonymous>
+
 io::stream_ptr tcp_io_stream::connect_to(const char* host,
                                           std::uint16_t port) {
     CPPA_LOGF_TRACE(CPPA_ARG(host) << ", " << CPPA_ARG(port));
     CPPA_LOGF_INFO("try to connect to " << host << " on port " << port);
-#   ifdef CPPA_WINDOWS
-    // make sure TCP has been initialized via WSAStartup
-    cppa::get_middleman();
-#   endif
-    sockaddr_in serv_addr;
-    hostent* server;
-    native_socket_type fd = socket(AF_INET, SOCK_STREAM, 0);
-    if (fd == invalid_socket) {
-        throw network_error("socket creation failed");
-    }
-    server = gethostbyname(host);
-    if (!server) {
-        std::string errstr = "no such host: ";
-        errstr += host;
-        throw network_error(std::move(errstr));
-    }
-    memset(&serv_addr, 0, sizeof(serv_addr));
-    serv_addr.sin_family = AF_INET;
-    memmove(&serv_addr.sin_addr.s_addr,
-            server->h_addr,
-            static_cast<size_t>(server->h_length));
-    serv_addr.sin_port = htons(port);
-    CPPA_LOGF_DEBUG("call connect()");
-    if (connect(fd, (const sockaddr*) &serv_addr, sizeof(serv_addr)) != 0) {
+    auto addrs = resolver::resolve(host, port);
+    native_socket_type fd;
+    try { fd = connect_any(addrs); }
+    catch (network_error&) {
         CPPA_LOGF_ERROR("could not connect to to " << host
                         << " on port " << port);
-        throw network_error("could not connect to host");
+        throw;
     }
     CPPA_LOGF_DEBUG("enable nodelay + nonblocking for socket");
     return from_sockfd(fd);
 }
 
+void tcp_io_stream::async_connect(middleman* parent,
+                                  socket_address_list addrs,
+                                  connect_handler hdl) {
+    CPPA_LOGF_TRACE(CPPA_ARG(addrs.size()));
+    async_connect_state_ptr state{
+        new async_connect_state(parent, std::move(addrs), std::move(hdl))};
+    state->start_next();
+}
+
 } // namespace util
 } // namespace cppa
 
@@ -20,10 +20,14 @@
 #include "cppa/config.hpp"
 
 #include <list>
+#include <map>
+#include <mutex>
 #include <memory>
+#include <algorithm>
 #include <cstring>    // memset
 #include <iostream>
 #include <stdexcept>
+#include <exception>
 #include <condition_variable>
 
 #ifndef CPPA_WINDOWS
@@ -45,18 +49,66 @@
 
 #include "cppa/io/acceptor.hpp"
 #include "cppa/io/middleman.hpp"
+#include "cppa/io/resolver.hpp"
 #include "cppa/io/peer_acceptor.hpp"
+#include "cppa/io/shm_acceptor.hpp"
 #include "cppa/io/tcp_acceptor.hpp"
 #include "cppa/io/tcp_io_stream.hpp"
+#include "cppa/io/unix_acceptor.hpp"
+#include "cppa/io/unix_io_stream.hpp"
 #include "cppa/io/remote_actor_proxy.hpp"
 
 namespace {
 
-constexpr std::uint32_t max_iface_size = 100;
+typedef std::set<std::string> string_set;
 
-constexpr std::uint32_t max_iface_clause_size = 500;
+struct published_port {
+    cppa::actor_id aid;
+    // false if the acceptor does not listen on a loopback interface
+    bool loopback;
+};
 
-typedef std::set<std::string> string_set;
+// TCP ports of actors published by this process, consulted by
+// remote_actor() before connecting to a host
+std::mutex s_published_mtx;
+std::map<std::uint16_t, published_port> s_published;
+
+bool listens_on_loopback(const char* addr) {
+    if (addr == nullptr) return true; // INADDR_ANY
+    try {
+        auto addrs = cppa::io::resolver::resolve(addr, 0);
+        return std::all_of(addrs.begin(), addrs.end(),
+                           [](const cppa::io::socket_address& sa) {
+            return sa.is_loopback();
+        });
+    }
+    catch (std::exception&) {
+        return false;
+    }
+}
+
+bool is_published(std::uint16_t port) {
+    std::lock_guard<std::mutex> guard{s_published_mtx};
+    return s_published.count(port) > 0;
+}
+
+// returns the actor published at @p port if @p addrs only contains
+// loopback addresses, i.e., if @p addrs refers to this process
+cppa::abstract_actor_ptr
+published_actor(const cppa::io::socket_address_list& addrs,
+                std::uint16_t port) {
+    auto is_loopback = [](const cppa::io::socket_address& sa) {
+        return sa.is_loopback();
+    };
+    if (!std::all_of(addrs.begin(), addrs.end(), is_loopback)) return nullptr;
+    std::lock_guard<std::mutex> guard{s_published_mtx};
+    auto i = s_published.find(port);
+    if (i == s_published.end() || !i->second.loopback) return nullptr;
+    auto ptr = cppa::get_actor_registry()->get(i->second.aid);
+    // the actor has finished execution and its acceptor is closed
+    if (!ptr) s_published.erase(i);
+    return ptr;
+}
 
 } // namespace <anonymous>
 
@@ -66,22 +118,92 @@ using namespace io;
 
 void publish(actor whom, std::uint16_t port, const char* addr) {
     if (!whom) return;
-    publish(std::move(whom), io::tcp_acceptor::create(port, addr));
+    detail::publish_impl(detail::raw_access::get(whom), port, addr);
 }
 
 void publish(actor whom, std::unique_ptr<io::acceptor> acceptor) {
     detail::publish_impl(detail::raw_access::get(whom), std::move(acceptor));
 }
 
+#ifndef CPPA_WINDOWS
+void publish(actor whom, const std::string& path) {
+    if (!whom) return;
+    publish(std::move(whom), io::unix_acceptor::create(path));
+}
+#endif // CPPA_WINDOWS
+
 actor remote_actor(io::stream_ptr_pair conn) {
     auto res = detail::remote_actor_impl(conn, string_set{});
     return detail::raw_access::unsafe_cast(res);
 }
 
 actor remote_actor(const char* host, std::uint16_t port) {
-    auto ptr = tcp_io_stream::connect_to(host, port);
+    auto res = detail::remote_actor_impl(host, port, string_set{});
+    return detail::raw_access::unsafe_cast(res);
+}
+
+#ifndef CPPA_WINDOWS
+actor remote_actor(const std::string& path) {
+    auto ptr = unix_io_stream::connect_to(path);
     return remote_actor(stream_ptr_pair(ptr, ptr));
 }
+#endif // CPPA_WINDOWS
+
+void remote_actor_async(const actor& listener,
+                        std::string host,
+                        std::uint16_t port) {
+    auto fail = [=](const std::string& what) {
+        anon_send(listener, atom("CONN_FAIL"), host, port, what);
+    };
+    auto failed = [=](std::exception_ptr eptr) {
+        try { std::rethrow_exception(eptr); }
+        catch (std::exception& e) { fail(e.what()); }
+    };
+    auto mm = get_middleman();
+    auto connect = [=](socket_address_list addrs, std::exception_ptr eptr) {
+        if (eptr) {
+            failed(eptr);
+            return;
+        }
+        auto local = published_actor(addrs, port);
+        if (local) {
+            CPPA_LOGF_INFO("remote_actor_async() called to access "
+                           "a local actor");
+            if (!local->interface().empty()) {
+                fail("interface of the local actor does not match "
+                     "the expected interface");
+                return;
+            }
+            anon_send(listener, atom("CONNECTED"), host, port,
+                      detail::raw_access::unsafe_cast(local));
+            return;
+        }
+        auto hdl = [=](abstract_actor_ptr res, std::exception_ptr err) {
+            if (err) {
+                failed(err);
+                return;
+            }
+            anon_send(listener, atom("CONNECTED"), host, port,
+                      detail::raw_access::unsafe_cast(res));
+        };
+        // the middleman drives all connection attempts and
+        // performs the handshake once one of them succeeded
+        tcp_io_stream::async_connect(mm, addrs,
+                                     [=](stream_ptr ptr,
+                                         std::exception_ptr err) {
+            if (err) {
+                failed(err);
+                return;
+            }
+            mm->new_client_peer(ptr, ptr, string_set{}, hdl);
+        });
+    };
+    // the resolver of the middleman invokes connect from the event loop
+    mm->run_later([=] {
+        CPPA_LOGC_TRACE("cppa", "remote_actor_async$resolve", "");
+        mm->get_resolver().async_resolve(host, port, connect);
+    });
+}
 
 namespace detail {
 
@@ -94,113 +216,87 @@ void publish_impl(abstract_actor_ptr ptr, std::unique_ptr<acceptor> aptr) {
     auto mm = get_middleman();
     auto addr = whom.address();
     auto sigs = whom->interface();
+#   ifdef CPPA_LINUX
+    // processes on this host reconnect to the actor via shared memory,
+    // see peer::reconnect_via_shm; the first publish() creates the endpoint
+    if (shm_transport()) {
+        try {
+            auto path = shm_acceptor::endpoint(*mm->node(), whom->id());
+            mm->register_acceptor(addr, new peer_acceptor(
+                                            mm, shm_acceptor::create(path),
+                                            addr, sigs));
+        }
+        catch (bind_failure&) { }
+        catch (network_error& e) {
+            CPPA_LOGF_WARNING("cannot accept shared memory connections: "
+                              << e.what());
+            static_cast<void>(e); // keep compiler happy
+        }
+    }
+#   endif
     mm->register_acceptor(addr, new peer_acceptor(mm, move(aptr),
                                                   addr, move(sigs)));
 }
 
+void publish_impl(abstract_actor_ptr ptr, std::uint16_t port,
+                  const char* addr) {
+    if (!ptr) return;
+    publish_impl(ptr, tcp_acceptor::create(port, addr));
+    // an ephemeral port is unknown to us
+    if (port == 0) return;
+    published_port entry{ptr->id(), listens_on_loopback(addr)};
+    std::lock_guard<std::mutex> guard{s_published_mtx};
+    s_published[port] = entry;
+}
+
+abstract_actor_ptr remote_actor_impl(const char* host, std::uint16_t port,
+                                     string_set expected) {
+    CPPA_LOGF_TRACE(CPPA_ARG(host) << ", " << CPPA_ARG(port));
+    // skip serialization and networking if the
+    // actor is published by this process
+    if (is_published(port)) {
+        auto res = published_actor(resolver::resolve(host, port), port);
+        if (res) {
+            CPPA_LOGF_INFO("remote_actor() called to access a local actor");
+            if (res->interface() != expected) {
+                throw std::invalid_argument("interface of the local actor "
+                                            "does not match the expected "
+                                            "interface");
+            }
+            return res;
+        }
+    }
+    auto ptr = tcp_io_stream::connect_to(host, port);
+    return remote_actor_impl(stream_ptr_pair(ptr, ptr), std::move(expected));
+}
+
 abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
     CPPA_LOGF_TRACE("io{" << io.first.get() << ", " << io.second.get() << "}");
     auto mm = get_middleman();
-    auto pinf = mm->node();
-    std::uint32_t process_id = pinf->process_id();
-    // throws on error
-    io.second->write(&process_id, sizeof(std::uint32_t));
-    io.second->write(pinf->host_id().data(), pinf->host_id().size());
-    // deserialize: actor id, process id, node id, interface
-    actor_id remote_aid;
-    std::uint32_t peer_pid;
-    node_id::host_id_type peer_node_id;
-    std::uint32_t iface_size;
-    std::set<std::string> iface;
-    auto& in = io.first;
-    // -> actor id
-    in->read(&remote_aid, sizeof(actor_id));
-    // -> process id
-    in->read(&peer_pid, sizeof(std::uint32_t));
-    // -> node id
-    in->read(peer_node_id.data(), peer_node_id.size());
-    // -> interface
-    in->read(&iface_size, sizeof(std::uint32_t));
-    if (iface_size > max_iface_size) {
-        throw std::invalid_argument("Remote actor claims to have more than"
-                                    +std::to_string(max_iface_size)+
-                                    " message types? Someone is trying"
-                                    " something nasty!");
-    }
-    std::vector<char> strbuf;
-    for (std::uint32_t i = 0; i < iface_size; ++i) {
-        std::uint32_t str_size;
-        in->read(&str_size, sizeof(std::uint32_t));
-        if (str_size > max_iface_clause_size) {
-            throw std::invalid_argument("Remote actor claims to have a"
-                                        " reply_to<...>::with<...> clause with"
-                                        " more than"
-                                        +std::to_string(max_iface_clause_size)+
-                                        " characters? Someone is"
-                                        " trying something nasty!");
-        }
-        strbuf.reserve(str_size + 1);
-        strbuf.resize(str_size);
-        in->read(strbuf.data(), str_size);
-        strbuf.push_back('\0');
-        iface.insert(std::string{strbuf.data()});
-    }
-    // deserialization done, check interface
-    if (iface != expected) {
-        auto tostr = [](const std::set<std::string>& what) -> std::string {
-            if (what.empty()) return "actor";
-            std::string tmp;
-            tmp = "typed_actor<";
-            auto i = what.begin();
-            auto e = what.end();
-            tmp += *i++;
-            while (i != e) tmp += *i++;
-            tmp += ">";
-            return tmp;
-        };
-        auto iface_str = tostr(iface);
-        auto expected_str = tostr(expected);
-        if (expected.empty()) {
-            throw std::invalid_argument("expected remote actor to be a "
-                                        "dynamically typed actor but found "
-                                        "a strongly typed actor of type "
-                                        + iface_str);
-        }
-        if (iface.empty()) {
-            throw std::invalid_argument("expected remote actor to be a "
-                                        "strongly typed actor of type "
-                                        + expected_str +
-                                        " but found a dynamically typed actor");
-        }
-        throw std::invalid_argument("expected remote actor to be a "
-                                    "strongly typed actor of type "
-                                    + expected_str +
-                                    " but found a strongly typed actor of type "
-                                    + iface_str);
-    }
-    auto pinfptr = make_counted<node_id>(peer_pid, peer_node_id);
-    if (*pinf == *pinfptr) {
-        // this is a local actor, not a remote actor
-        CPPA_LOGF_INFO("remote_actor() called to access a local actor");
-        auto ptr = get_actor_registry()->get(remote_aid);
-        return ptr;
-    }
-    struct remote_actor_result { remote_actor_result* next; actor value; };
+    struct remote_actor_result {
+        remote_actor_result* next;
+        abstract_actor_ptr value;
+        std::exception_ptr error;
+    };
     std::mutex qmtx;
     std::condition_variable qcv;
     intrusive::single_reader_queue<remote_actor_result> q;
-    mm->run_later([mm, io, pinfptr, remote_aid, &q, &qmtx, &qcv] {
+    // the handshake is performed by the middleman, we only
+    // wait for its result
+    mm->run_later([mm, io, &expected, &q, &qmtx, &qcv] {
         CPPA_LOGC_TRACE("cppa",
                         "remote_actor$create_connection", "");
-        auto pp = mm->get_peer(*pinfptr);
-        CPPA_LOGF_INFO_IF(pp, "connection already exists (re-use old one)");
-        if (!pp) mm->new_peer(io.first, io.second, pinfptr);
-        auto res = mm->get_namespace().get_or_put(pinfptr, remote_aid);
-        q.synchronized_enqueue(qmtx, qcv, new remote_actor_result{0, res});
+        auto hdl = [&](abstract_actor_ptr res, std::exception_ptr eptr) {
+            q.synchronized_enqueue(qmtx, qcv,
+                                   new remote_actor_result{0, std::move(res),
+                                                           std::move(eptr)});
+        };
+        mm->new_client_peer(io.first, io.second, std::move(expected), hdl);
     });
     std::unique_ptr<remote_actor_result> result(q.synchronized_pop(qmtx, qcv));
     CPPA_LOGF_DEBUG(CPPA_MARG(result, get));
-    return raw_access::get(result->value);
+    if (result->error) std::rethrow_exception(result->error);
+    return result->value;
 }
 
 } // namespace util
@@ -18,11 +18,14 @@
 
 
 #include <array>
+#include <mutex>
+#include <atomic>
 #include <limits>
 #include <string>
 #include <vector>
 #include <cstring>
 #include <algorithm>
+#include <functional>
 #include <type_traits>
 
 #include "cppa/group.hpp"
@@ -34,6 +37,7 @@
 #include "cppa/actor_namespace.hpp"
 
 #include "cppa/util/duration.hpp"
+#include "cppa/util/byte_slice.hpp"
 #include "cppa/util/algorithm.hpp"
 #include "cppa/util/scope_guard.hpp"
 #include "cppa/util/limited_vector.hpp"
@@ -69,11 +73,13 @@ namespace detail {
     { "cppa::message_header",                           "@header"             },
     { "cppa::new_connection_msg",                       "@new_conn"           },
     { "cppa::new_data_msg",                             "@new_data"           },
+    { "cppa::peer_congested_msg",                       "@peer_congested"     },
     { "cppa::sync_exited_msg",                          "@sync_exited"        },
     { "cppa::sync_timeout_msg",                         "@sync_timeout"       },
     { "cppa::timeout_msg",                              "@timeout"            },
     { "cppa::unit_t",                                   "@0"                  },
     { "cppa::util::buffer",                             "@buffer"             },
+    { "cppa::util::byte_slice",                         "@slice"              },
     { "cppa::util::duration",                           "@duration"           },
     { "double",                                         "double"              },
     { "float",                                          "float"               },
@@ -277,19 +283,12 @@ void deserialize_impl(channel& ptrref, deserializer* source) {
 }
 
 void serialize_impl(const any_tuple& tup, serializer* sink) {
-    std::string dynamic_name; // used if tup holds an object_array
-    // ttn can be nullptr even if tuple is not empty (in case of object_array)
-    const std::string* ttn = tup.empty() ? nullptr : tup.tuple_type_names();
-    const char* tname = ttn ? ttn->data() : (tup.empty() ? "@<>" : nullptr);
-    if (!tname) {
-        // tuple is not empty, i.e., we are dealing with an object array
-        dynamic_name = detail::get_tuple_type_names(*tup.vals());
-        tname = dynamic_name.c_str();
-    }
-    auto uti = get_uniform_type_info_map()->by_uniform_name(tname);
+    static const std::string empty_tuple_name = "@<>";
+    auto tname = tup.empty() ? &empty_tuple_name : tup.tuple_type_names();
+    auto uti = get_uniform_type_info_map()->by_uniform_name(*tname);
     if (uti == nullptr) {
         std::string err = "could not get uniform type info for \"";
-        err += tname;
+        err += *tname;
         err += "\"";
         CPPA_LOGF_ERROR(err);
         throw std::runtime_error(err);
@@ -354,6 +353,16 @@ inline void deserialize_impl(atom_value& val, deserializer* source) {
     val = source->read<atom_value>();
 }
 
+inline void serialize_impl(const util::byte_slice& val, serializer* sink) {
+    sink->write_value(static_cast<uint32_t>(val.size()));
+    sink->write_raw(val.size(), val.data());
+}
+
+inline void deserialize_impl(util::byte_slice& val, deserializer* source) {
+    auto s = source->read<uint32_t>();
+    val = source->read_slice(s);
+}
+
 inline void serialize_impl(const util::duration& val, serializer* sink) {
     sink->write_value(static_cast<uint32_t>(val.unit));
     sink->write_value(val.count);
@@ -422,6 +431,14 @@ inline void deserialize_impl(group_down_msg& dm, deserializer* source) {
     deserialize_impl(dm.source, source);
 }
 
+inline void serialize_impl(const peer_congested_msg& pcm, serializer* sink) {
+    serialize_impl(pcm.source, sink);
+}
+
+inline void deserialize_impl(peer_congested_msg& pcm, deserializer* source) {
+    deserialize_impl(pcm.source, source);
+}
+
 inline void serialize_impl(const timeout_msg& tm, serializer* sink) {
     sink->write_value(tm.timeout_id);
 }
@@ -804,6 +821,13 @@ class utim_impl : public uniform_type_info_map {
  public:
 
     void initialize() {
+        for (auto& slot : m_name_cache) {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+        for (auto& slot : m_rtti_cache) {
+            slot.key.store(nullptr, std::memory_order_relaxed);
+            slot.value.store(nullptr, std::memory_order_relaxed);
+        }
         // maps sizeof(integer_type) to {signed_type, unsigned_type}
         abstract_int_tinfo* mapping[][2] = {
             {nullptr, nullptr},         // no integer type for sizeof(T) == 0
@@ -859,7 +883,9 @@ class utim_impl : public uniform_type_info_map {
         *i++ = &m_type_long_double;         // @ldouble
         *i++ = &m_new_connection_msg;       // @new_conn
         *i++ = &m_new_data_msg;             // @new_data
+        *i++ = &m_type_peer_congested;      // @peer_congested
         *i++ = &m_type_proc;                // @proc
+        *i++ = &m_type_slice;               // @slice
         *i++ = &m_type_str;                 // @str
         *i++ = &m_type_strmap;              // @strmap
         *i++ = &m_type_sync_exited;         // @sync_exited
@@ -909,23 +935,45 @@ class utim_impl : public uniform_type_info_map {
     }
 
     pointer by_rtti(const std::type_info& ti) const {
+        auto hash = ti.hash_code();
+        for (size_t n = 0; n < max_cache_probes; ++n) {
+            auto& slot = m_rtti_cache[(hash + n) % cache_size];
+            auto key = slot.key.load(std::memory_order_acquire);
+            if (key == nullptr) break;
+            if (*key == ti) {
+                // the value is set shortly after claiming the slot
+                auto res = slot.value.load(std::memory_order_acquire);
+                if (res) return res;
+                break;
+            }
+        }
         util::shared_lock_guard<util::shared_spinlock> guard(m_lock);
         auto res = find_rtti(m_builtin_types, ti);
-        return (res) ? res : find_rtti(m_user_types, ti);
+        res = (res) ? res : find_rtti(m_user_types, ti);
+        if (res) cache_rtti(ti, res);
+        return res;
     }
 
     pointer by_uniform_name(const std::string& name) {
+        auto hash = std::hash<std::string>{}(name);
+        for (size_t n = 0; n < max_cache_probes; ++n) {
+            auto res = m_name_cache[(hash + n) % cache_size].load(
+                           std::memory_order_acquire);
+            if (res == nullptr) break;
+            if (name == res->name()) return res;
+        }
         pointer result = nullptr;
         /* lifetime scope of guard */ {
             util::shared_lock_guard<util::shared_spinlock> guard(m_lock);
             result = find_name(m_builtin_types, name);
             result = (result) ? result : find_name(m_user_types, name);
+            if (result) cache_name(hash, result);
         }
         if (!result && name.compare(0, 3, "@<>") == 0) {
             // create tuple UTI on-the-fly
             result = insert(create_unique<default_meta_tuple>(name));
         }
-        return result; //(res) ? res : find_name(m_user_types, name);
+        return result;
     }
 
     std::vector<pointer> get_all() const {
@@ -950,6 +998,15 @@ class utim_impl : public uniform_type_info_map {
         }
         else {
             if (strcmp(uti->name(), (*i)->name()) == 0) {
+                // a statically typed hint replaces a tuple type that was
+                // created on-the-fly; the old instance is kept alive,
+                // because callers might still hold a pointer to it
+                if (   dynamic_cast<default_meta_tuple*>(*i) != nullptr
+                    && dynamic_cast<default_meta_tuple*>(uti.get()) == nullptr) {
+                    m_replaced_types.push_back(*i);
+                    *i = uti.release();
+                    replace_cached(m_replaced_types.back(), *i);
+                }
                 // type already known
                 return *i;
             }
@@ -963,6 +1020,8 @@ class utim_impl : public uniform_type_info_map {
     ~utim_impl() {
         for (auto ptr : m_user_types) delete ptr;
         m_user_types.clear();
+        for (auto ptr : m_replaced_types) delete ptr;
+        m_replaced_types.clear();
     }
 
  private:
@@ -1005,7 +1064,7 @@ class utim_impl : public uniform_type_info_map {
     int_tinfo<std::uint8_t>                 m_type_u8;
     int_tinfo<std::int16_t>                 m_type_i16;
 
-    // 30-38
+    // 30-39
     int_tinfo<std::uint16_t>                m_type_u16;
     int_tinfo<std::int32_t>                 m_type_i32;
     int_tinfo<std::uint32_t>                m_type_u32;
@@ -1015,12 +1074,73 @@ class utim_impl : public uniform_type_info_map {
     uti_impl<new_data_msg>                  m_new_data_msg;
     uti_impl<connection_closed_msg>         m_connection_closed_msg;
     uti_impl<acceptor_closed_msg>           m_acceptor_closed_msg;
+    uti_impl<peer_congested_msg>            m_type_peer_congested;
+
+    // 40-49
+    uti_impl<util::byte_slice>              m_type_slice;
 
     // both containers are sorted by uniform name
-    std::array<pointer, 39> m_builtin_types;
+    std::array<pointer, 41> m_builtin_types;
     std::vector<uniform_type_info*> m_user_types;
+    std::vector<uniform_type_info*> m_replaced_types;
     mutable util::shared_spinlock m_lock;
 
+    // successful lookups are cached in open-addressed hash tables of fixed
+    // size that are read without locking; slots are filled once and never
+    // cleared, a lookup probing max_cache_probes slots without a match
+    // falls back to searching the containers above
+    static constexpr size_t cache_size = 1024;
+
+    static constexpr size_t max_cache_probes = 8;
+
+    struct rtti_slot {
+        std::atomic<const std::type_info*> key;
+        std::atomic<pointer> value;
+    };
+
+    mutable std::array<std::atomic<pointer>, cache_size> m_name_cache;
+    mutable std::array<rtti_slot, cache_size> m_rtti_cache;
+
+    // m_lock must be held, i.e., insert() cannot replace the type meanwhile
+    void cache_name(size_t hash, pointer uti) const {
+        for (size_t n = 0; n < max_cache_probes; ++n) {
+            pointer expected = nullptr;
+            auto& slot = m_name_cache[(hash + n) % cache_size];
+            if (   slot.compare_exchange_strong(expected, uti)
+                || expected == uti) {
+                return;
+            }
+        }
+    }
+
+    // m_lock must be held, i.e., insert() cannot replace the type meanwhile
+    void cache_rtti(const std::type_info& ti, pointer uti) const {
+        auto hash = ti.hash_code();
+        for (size_t n = 0; n < max_cache_probes; ++n) {
+            const std::type_info* expected = nullptr;
+            auto& slot = m_rtti_cache[(hash + n) % cache_size];
+            if (slot.key.compare_exchange_strong(expected, &ti)) {
+                slot.value.store(uti, std::memory_order_release);
+                return;
+            }
+            // another thread might still be about to set the value
+            if (*expected == ti) return;
+        }
+    }
+
+    // updates cached lookups of a replaced type; m_lock must be held
+    // exclusively, i.e., no other thread fills the caches meanwhile
+    void replace_cached(pointer old_uti, pointer new_uti) {
+        for (auto& slot : m_name_cache) {
+            pointer expected = old_uti;
+            slot.compare_exchange_strong(expected, new_uti);
+        }
+        for (auto& slot : m_rtti_cache) {
+            pointer expected = old_uti;
+            slot.value.compare_exchange_strong(expected, new_uti);
+        }
+    }
+
     template<typename Container>
     pointer find_rtti(const Container& c, const std::type_info& ti) const {
         auto e = c.end();
@@ -1051,6 +1171,10 @@ uniform_type_info_map* uniform_type_info_map::create_singleton() {
 
 uniform_type_info_map::~uniform_type_info_map() { }
 
+void add_tuple_hint(uniform_type_info* hint) {
+    get_uniform_type_info_map()->insert(std::unique_ptr<uniform_type_info>{hint});
+}
+
 } // namespace util
 } // namespace cppa
 
@@ -0,0 +1,155 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include "cppa/config.hpp"
+
+#ifndef CPPA_WINDOWS
+
+#include <cstring>
+#include <errno.h>
+
+#include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
+
+#include "cppa/io/stream.hpp"
+#include "cppa/io/unix_acceptor.hpp"
+#include "cppa/io/unix_io_stream.hpp"
+
+#include "cppa/detail/fd_util.hpp"
+
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+namespace cppa {
+namespace io {
+
+using namespace ::cppa::detail::fd_util;
+
+namespace {
+
+// returns true if a process accepts connections on @p addr
+bool is_listening(const sockaddr_un& addr) {
+    native_socket_type fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == invalid_socket) return false;
+    auto res = connect(fd, reinterpret_cast<const sockaddr*>(&addr),
+                       sizeof(addr));
+    closesocket(fd);
+    return res == 0;
+}
+
+bool accept_impl(stream_ptr_pair& result,
+                 native_socket_type fd,
+                 bool nonblocking) {
+    auto sfd = ::accept(fd, nullptr, nullptr);
+    if (sfd == invalid_socket) {
+        auto err = last_socket_error();
+        CPPA_LOGF_DEBUG("accept failed for reason " << err);
+        if (nonblocking && would_block_or_temporarily_unavailable(err)) {
+            // ok, try again
+            return false;
+        }
+        throw_io_failure("accept failed");
+    }
+    stream_ptr ptr(unix_io_stream::from_sockfd(sfd));
+    result.first = ptr;
+    result.second = ptr;
+    return true;
+}
+
+} // namespace <anonymous>
+
+unix_acceptor::unix_acceptor(native_socket_type fd, std::string path)
+: m_fd(fd), m_is_nonblocking(true), m_path(std::move(path)) { }
+
+std::unique_ptr<acceptor> unix_acceptor::create(const std::string& path) {
+    CPPA_LOGM_TRACE("unix_acceptor", CPPA_ARG(path));
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw network_error("path too long for a Unix domain socket: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size());
+    native_socket_type sockfd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sockfd == invalid_socket) {
+        throw network_error("could not create server socket");
+    }
+    auto addr_ptr = reinterpret_cast<const sockaddr*>(&addr);
+    if (bind(sockfd, addr_ptr, sizeof(addr)) < 0) {
+        auto err = errno;
+        // replace the socket file of a process that no longer exists
+        if (err != EADDRINUSE || is_listening(addr)
+                || unlink(path.c_str()) != 0
+                || bind(sockfd, addr_ptr, sizeof(addr)) < 0) {
+            closesocket(sockfd);
+            throw bind_failure(err);
+        }
+    }
+    if (listen(sockfd, SOMAXCONN) != 0) {
+        closesocket(sockfd);
+        unlink(path.c_str());
+        throw network_error("listen() failed");
+    }
+    try { nonblocking(sockfd, true); }
+    catch (...) {
+        closesocket(sockfd);
+        unlink(path.c_str());
+        throw;
+    }
+    CPPA_LOGM_DEBUG("unix_acceptor", "sockfd = " << sockfd);
+    return std::unique_ptr<acceptor>(new unix_acceptor(sockfd, path));
+}
+
+unix_acceptor::~unix_acceptor() {
+    closesocket(m_fd);
+    unlink(m_path.c_str());
+}
+
+native_socket_type unix_acceptor::file_handle() const {
+    return m_fd;
+}
+
+stream_ptr_pair unix_acceptor::accept_connection() {
+    if (m_is_nonblocking) {
+        nonblocking(m_fd, false);
+        m_is_nonblocking = false;
+    }
+    stream_ptr_pair result;
+    accept_impl(result, m_fd, m_is_nonblocking);
+    return result;
+}
+
+optional<stream_ptr_pair> unix_acceptor::try_accept_connection() {
+    if (!m_is_nonblocking) {
+        nonblocking(m_fd, true);
+        m_is_nonblocking = true;
+    }
+    stream_ptr_pair result;
+    if (accept_impl(result, m_fd, m_is_nonblocking)) {
+        return result;
+    }
+    return none;
+}
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_WINDOWS
@@ -0,0 +1,73 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011 - 2014                                                  *
+ * Dominik Charousset <dominik.charousset (at) haw-hamburg.de>                *
+ *                                                                            *
+ * Distributed under the Boost Software License, Version 1.0. See             *
+ * accompanying file LICENSE or copy at http://www.boost.org/LICENSE_1_0.txt  *
+\******************************************************************************/
+
+
+#include "cppa/config.hpp"
+
+#ifndef CPPA_WINDOWS
+
+#include <cstring>
+#include <errno.h>
+
+#include "cppa/logging.hpp"
+#include "cppa/exception.hpp"
+#include "cppa/detail/fd_util.hpp"
+#include "cppa/io/unix_io_stream.hpp"
+
+#include <unistd.h>
+#include <sys/un.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+namespace cppa {
+namespace io {
+
+using namespace ::cppa::detail::fd_util;
+
+unix_io_stream::unix_io_stream(native_socket_type fd) : tcp_io_stream(fd) { }
+
+stream_ptr unix_io_stream::from_sockfd(native_socket_type fd) {
+    nonblocking(fd, true);
+    return new unix_io_stream(fd);
+}
+
+stream_ptr unix_io_stream::connect_to(const std::string& path) {
+    CPPA_LOGF_TRACE(CPPA_ARG(path));
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw network_error("path too long for a Unix domain socket: " + path);
+    }
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, path.c_str(), path.size());
+    native_socket_type fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd == invalid_socket) {
+        throw network_error("socket creation failed");
+    }
+    if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) != 0) {
+        closesocket(fd);
+        CPPA_LOGF_ERROR("could not connect to " << path);
+        throw_io_failure("could not connect to Unix domain socket");
+    }
+    return from_sockfd(fd);
+}
+
+} // namespace io
+} // namespace cppa
+
+#endif // CPPA_WINDOWS
@@ -0,0 +1,74 @@
+#include <string>
+#include <random>
+#include <cstring>
+
+#include "test.hpp"
+
+#include "cppa/util/buffer.hpp"
+#include "cppa/util/compression.hpp"
+
+using namespace cppa;
+
+namespace {
+
+bool round_trip(const std::string& what, size_t* compressed_size = nullptr) {
+    util::buffer compressed;
+    util::compress(what.data(), what.size(), compressed);
+    if (compressed_size) *compressed_size = compressed.size();
+    util::buffer restored;
+    if (!util::decompress(compressed.data(), compressed.size(),
+                          restored, what.size())) {
+        return false;
+    }
+    return    restored.size() == what.size()
+           && memcmp(restored.data(), what.data(), what.size()) == 0;
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test_compression);
+    CPPA_CHECK(round_trip(""));
+    CPPA_CHECK(round_trip("a"));
+    CPPA_CHECK(round_trip("abcd"));
+    CPPA_CHECK(round_trip("hello world, hello world, hello world"));
+    // runs overlapping with their own output
+    size_t compressed_size = 0;
+    CPPA_CHECK(round_trip(std::string(100000, 'x'), &compressed_size));
+    CPPA_CHECK(compressed_size < 1000);
+    std::string text;
+    for (int i = 0; i < 5000; ++i) {
+        text += "{'actor', " + std::to_string(i % 97) + ", \"payload\"} ";
+    }
+    CPPA_CHECK(round_trip(text, &compressed_size));
+    CPPA_CHECK(compressed_size < text.size() / 4);
+    // random data does not compress but must survive a round trip
+    std::mt19937 gen(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+    std::string noise;
+    for (int i = 0; i < 70000; ++i) noise += static_cast<char>(dist(gen));
+    CPPA_CHECK(round_trip(noise, &compressed_size));
+    CPPA_CHECK(compressed_size < noise.size() + noise.size() / 100 + 16);
+    // malformed or oversized input is rejected
+    util::buffer compressed;
+    util::compress(text.data(), text.size(), compressed);
+    util::buffer restored;
+    CPPA_CHECK(!util::decompress(compressed.data(), compressed.size(),
+                                 restored, text.size() - 1));
+    for (size_t n = 0; n < compressed.size(); n += 97) {
+        restored.clear();
+        CPPA_CHECK(!util::decompress(compressed.data(), n,
+                                     restored, text.size()));
+    }
+    auto bytes = static_cast<unsigned char*>(compressed.data());
+    for (size_t i = sizeof(std::uint32_t); i < compressed.size(); i += 13) {
+        bytes[i] ^= 0xFF;
+        restored.clear();
+        // must neither crash nor exceed the announced size
+        util::decompress(compressed.data(), compressed.size(),
+                         restored, text.size());
+        CPPA_CHECK(restored.size() <= text.size());
+        bytes[i] ^= 0xFF;
+    }
+    return CPPA_TEST_RESULT();
+}
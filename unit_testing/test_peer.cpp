@@ -0,0 +1,223 @@
+#include <thread>
+#include <vector>
+#include <memory>
+#include <future>
+#include <string>
+#include <functional>
+
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+#include "test.hpp"
+
+#include "cppa/cppa.hpp"
+#include "cppa/node_id.hpp"
+#include "cppa/singletons.hpp"
+#include "cppa/actor_namespace.hpp"
+
+#include "cppa/detail/raw_access.hpp"
+
+#include "cppa/io/peer.hpp"
+#include "cppa/io/middleman.hpp"
+#include "cppa/io/unix_io_stream.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+// runs f in the event loop of the middleman and returns its result
+template<typename T>
+T in_middleman(function<T ()> f) {
+    promise<T> result;
+    get_middleman()->run_later([&] { result.set_value(f()); });
+    return result.get_future().get();
+}
+
+node_id_ptr fake_node(uint32_t process_id) {
+    node_id::host_id_type hid;
+    hid.fill(0xAB);
+    return new node_id(process_id, hid);
+}
+
+// creates a proxy for the actor with ID 42 on @p node
+actor fake_proxy(const node_id_ptr& node) {
+    return in_middleman<actor>([=] {
+        auto ptr = get_middleman()->get_namespace().get_or_put(node, 42);
+        return detail::raw_access::unsafe_cast(ptr.get());
+    });
+}
+
+// sends @p num copies of @p msg to @p dest from a new actor and returns
+// the number of peer_congested_msg messages it received in response
+size_t count_bounces(const actor& dest, size_t num, any_tuple msg) {
+    scoped_actor self;
+    actor client = self;
+    spawn([=](event_based_actor* ptr) {
+        for (size_t i = 0; i < num; ++i) ptr->send_tuple(dest, msg);
+        auto bounces = make_shared<size_t>(0);
+        ptr->become (
+            on_arg_match >> [=](const peer_congested_msg& pcm) {
+                CPPA_CHECK(pcm.source == dest.address());
+                ++*bounces;
+            },
+            after(chrono::milliseconds(500)) >> [=] {
+                ptr->send(client, *bounces);
+                ptr->quit();
+            }
+        );
+    });
+    size_t result = 0;
+    self->receive (
+        on_arg_match >> [&](size_t bounces) {
+            result = bounces;
+        }
+    );
+    return result;
+}
+
+void test_congestion() {
+    CPPA_PRINT("test congestion of a connected node");
+    peer_buffer_watermarks(64 * 1024, 256 * 1024);
+    int fds[2];
+    CPPA_CHECK_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    // keep the socket buffers small to make the peer buffer data
+    int bufsize = 16 * 1024;
+    setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+    setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
+    auto node = fake_node(1);
+    auto stream = io::unix_io_stream::from_sockfd(fds[0]);
+    in_middleman<bool>([=] {
+        get_middleman()->new_peer(stream, stream, node);
+        return true;
+    });
+    auto dest = fake_proxy(node);
+    // nobody reads from fds[1], i.e., the data piles up in the peer
+    auto blob = make_any_tuple(string(16 * 1024, 'x'));
+    CPPA_CHECK(count_bounces(dest, 256, blob) > 0);
+    // drain the connection until the peer is no longer congested
+    thread reader([=] {
+        char buf[4096];
+        while (read(fds[1], buf, sizeof(buf)) > 0) { }
+    });
+    auto mm = get_middleman();
+    auto buffered = [=]() -> size_t {
+        auto ptr = mm->get_peer(*node);
+        return ptr ? ptr->buffered_bytes() : 0;
+    };
+    for (int i = 0; i < 500 && in_middleman<size_t>(buffered) > 0; ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    CPPA_CHECK_EQUAL(in_middleman<size_t>(buffered), 0);
+    CPPA_CHECK_EQUAL(count_bounces(dest, 1, blob), 0);
+    shutdown(fds[1], SHUT_RDWR);
+    reader.join();
+    close(fds[1]);
+}
+
+void test_congestion_without_connection() {
+    CPPA_PRINT("test congestion of a node without connection");
+    peer_buffer_watermarks(16 * 1024, 64 * 1024);
+    // messages to a node without connection wait in a queue
+    auto dest = fake_proxy(fake_node(2));
+    auto max_queued =   peer_buffer_high_watermark()
+                      / io::default_message_queue::estimated_message_size;
+    auto bounces = count_bounces(dest, max_queued + 100,
+                                 make_any_tuple(atom("ping")));
+    CPPA_CHECK(bounces >= 100);
+    CPPA_CHECK(bounces <= 101);
+}
+
+void test_large_type_dictionary() {
+    CPPA_PRINT("test type dictionary exceeding max_msg_size()");
+    auto old_max_msg_size = max_msg_size();
+    max_msg_size(1024);
+    int fds[2];
+    CPPA_CHECK_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    auto stream = io::unix_io_stream::from_sockfd(fds[0]);
+    in_middleman<bool>([=] {
+        get_middleman()->new_peer(stream, stream);
+        return true;
+    });
+    // act as connecting node: send process information,
+    // feature flags and 200 type name hashes
+    auto node = fake_node(3);
+    vector<char> buf;
+    auto append = [&](const void* data, size_t size) {
+        auto first = static_cast<const char*>(data);
+        buf.insert(buf.end(), first, first + size);
+    };
+    uint32_t pid = node->process_id();
+    append(&pid, sizeof(pid));
+    append(node->host_id().data(), node_id::host_id_size);
+    uint32_t features = 0;
+    uint32_t count = 200;
+    append(&features, sizeof(features));
+    append(&count, sizeof(count));
+    for (uint64_t hash = 1; hash <= count; ++hash) {
+        append(&hash, sizeof(hash));
+    }
+    CPPA_CHECK(buf.size() > max_msg_size());
+    CPPA_CHECK_EQUAL(write(fds[1], buf.data(), buf.size()),
+                     static_cast<ssize_t>(buf.size()));
+    // the peer registers itself once it has read the type dictionary
+    auto mm = get_middleman();
+    auto registered = [=] { return mm->get_peer(*node) != nullptr; };
+    for (int i = 0; i < 500 && !in_middleman<bool>(registered); ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    CPPA_CHECK(in_middleman<bool>(registered));
+    max_msg_size(old_max_msg_size);
+    close(fds[1]);
+}
+
+void test_incoming_transfer_limit() {
+    CPPA_PRINT("test limit of partially received messages");
+    auto old_max_msg_size = max_msg_size();
+    max_msg_size(1024);
+    int fds[2];
+    CPPA_CHECK_EQUAL(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    timeval timeout{5, 0};
+    setsockopt(fds[1], SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    auto node = fake_node(4);
+    // the peer must own its stream to close the connection on error
+    auto fd = fds[0];
+    in_middleman<bool>([=] {
+        auto stream = io::unix_io_stream::from_sockfd(fd);
+        get_middleman()->new_peer(stream, stream, node);
+        return true;
+    });
+    // sends the first 16 bytes of a message with max_msg_size() bytes,
+    // i.e., a chunk frame of 24 bytes including transfer ID and size
+    auto send_chunk = [&](uint32_t id) {
+        uint32_t chunk[] = {24 | 0x40000000, id, 1024, 0, 0, 0, 0};
+        return write(fds[1], chunk, sizeof(chunk)) == sizeof(chunk);
+    };
+    // a connection reserves at most 4 * max_msg_size() bytes
+    // for partially received messages
+    for (uint32_t id = 0; id < 4; ++id) CPPA_CHECK(send_chunk(id));
+    this_thread::sleep_for(chrono::milliseconds(100));
+    auto mm = get_middleman();
+    auto connected = [=] { return mm->get_peer(*node) != nullptr; };
+    CPPA_CHECK(in_middleman<bool>(connected));
+    CPPA_CHECK(send_chunk(4));
+    char dummy;
+    CPPA_CHECK_EQUAL(read(fds[1], &dummy, 1), 0);
+    max_msg_size(old_max_msg_size);
+    close(fds[1]);
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test_peer);
+    test_congestion();
+    test_congestion_without_connection();
+    test_large_type_dictionary();
+    test_incoming_transfer_limit();
+    await_all_actors_done();
+    shutdown();
+    return CPPA_TEST_RESULT();
+}
@@ -1,6 +1,8 @@
 #include <thread>
+#include <future>
 #include <string>
 #include <cstring>
+#include <fstream>
 #include <sstream>
 #include <iostream>
 #include <functional>
@@ -11,6 +13,14 @@
 #include "cppa/logging.hpp"
 #include "cppa/exception.hpp"
 
+#include "cppa/io/resolver.hpp"
+#include "cppa/io/middleman.hpp"
+#include "cppa/io/shm_acceptor.hpp"
+#include "cppa/io/shm_io_stream.hpp"
+#include "cppa/io/tcp_io_stream.hpp"
+
+#include "cppa/util/byte_slice.hpp"
+
 #include "cppa/detail/raw_access.hpp"
 
 using namespace std;
@@ -22,6 +32,80 @@ typedef std::pair<std::string, std::string> string_pair;
 
 typedef vector<actor> actor_vector;
 
+constexpr size_t blob_size = 1024 * 1024;
+
+constexpr int num_fan_outs = 3;
+
+string unix_socket_path(uint16_t port) {
+    return "/tmp/cppa_test_remote_actor_" + std::to_string(port) + ".sock";
+}
+
+string shm_socket_path(uint16_t port) {
+    return "/tmp/cppa_test_remote_actor_" + std::to_string(port) + ".shm";
+}
+
+#ifdef CPPA_LINUX
+// counts the shared memory regions of io::shm_io_stream connections
+size_t num_shm_mappings() {
+    size_t result = 0;
+    ifstream maps("/proc/self/maps");
+    string line;
+    while (getline(maps, line)) {
+        if (line.find("cppa_shm_stream") != string::npos) ++result;
+    }
+    return result;
+}
+#endif // CPPA_LINUX
+
+// publishes @p serv at the first free port starting at 4242
+uint16_t publish_at_free_port(const actor& serv, const char* addr) {
+    uint16_t port = 4242;
+    for (;;) {
+        try {
+            publish(serv, port, addr);
+            CPPA_LOGF_DEBUG("running on port " << port);
+            return port;
+        }
+        catch (bind_failure&) {
+            // try next port
+            ++port;
+        }
+    }
+}
+
+void check_remote_actor_async(scoped_actor& self, const actor& serv,
+                              const string& host, uint16_t port) {
+    remote_actor_async(self, host, port);
+    self->receive (
+        on(atom("CONNECTED"), host, port, arg_match)
+        >> [&](const actor& res) {
+            CPPA_CHECK(serv == res);
+        },
+        on(atom("CONN_FAIL"), arg_match)
+        >> [&](const string&, uint16_t, const string& err) {
+            CPPA_FAILURE("remote_actor_async failed: " << err);
+        }
+    );
+}
+
+// connects asynchronously to a list of addresses starting with a
+// closed port, i.e., the middleman has to fail over to the next one
+void check_async_failover(uint16_t port) {
+    auto addrs = io::resolver::resolve("::1", 1);
+    auto valid = io::resolver::resolve("127.0.0.1", port);
+    addrs.insert(addrs.end(), valid.begin(), valid.end());
+    auto mm = get_middleman();
+    promise<bool> connected;
+    mm->run_later([&] {
+        io::tcp_io_stream::async_connect(mm, addrs,
+                                         [&](io::stream_ptr ptr,
+                                             exception_ptr eptr) {
+            connected.set_value(ptr != nullptr && eptr == nullptr);
+        });
+    });
+    CPPA_CHECK(connected.get_future().get());
+}
+
 void reflector(event_based_actor* self) {
     self->become (
         others() >> [=] {
@@ -179,6 +263,18 @@ class client : public event_based_actor {
     }
 
     void send_sync_msg() {
+        // large enough to be sent in chunks, must arrive before 'SyncMsg'
+        CPPA_PRINT("send {'Blob', ...}");
+        auto blob = make_any_tuple(atom("Blob"),
+                                   util::byte_slice(string(blob_size, 'x')));
+        // sending the same tuple again reuses its serialized content
+        auto fan_out = make_any_tuple(atom("FanOut"), m_server);
+        for (int i = 0; i < num_fan_outs; ++i) {
+            send_tuple(m_server, blob);
+            send_tuple(m_server, fan_out);
+        }
+        // sent in the priority lane, may overtake 'Blob'
+        send(message_priority::high, m_server, atom("Urgent"));
         CPPA_PRINT("sync send {'SyncMsg', 4.2fSyncMsg}");
         sync_send(m_server, atom("SyncMsg"), 4.2f).then(
             on(atom("SyncReply")) >> [=] {
@@ -266,10 +362,32 @@ class server : public event_based_actor {
     }
 
     void await_sync_msg() {
-        CPPA_PRINT("await {'SyncMsg'}");
+        CPPA_PRINT("await {'Blob', ...}, {'Urgent'} and {'SyncMsg'}");
+        auto blobs_received = make_shared<int>(0);
+        auto fan_outs_received = make_shared<int>(0);
+        auto urgent_received = make_shared<bool>(false);
         become (
+            on(atom("Urgent")) >> [=] {
+                *urgent_received = true;
+            },
+            on(atom("Blob"), arg_match) >> [=](const util::byte_slice& blob) {
+                CPPA_CHECK_EQUAL(blob.size(), blob_size);
+                CPPA_CHECK(blob.str() == string(blob_size, 'x'));
+                // the slice refers to the buffer of the received message
+                CPPA_CHECK(blob.storage()->get().size() > blob.size());
+                CPPA_CHECK_EQUAL(*fan_outs_received, *blobs_received);
+                ++*blobs_received;
+            },
+            on(atom("FanOut"), arg_match) >> [=](const actor& whom) {
+                CPPA_CHECK(whom.address() == address());
+                ++*fan_outs_received;
+                CPPA_CHECK_EQUAL(*fan_outs_received, *blobs_received);
+            },
             on(atom("SyncMsg"), arg_match) >> [=](float f) -> atom_value {
                 CPPA_PRINT("received {'SyncMsg', " << f << "}");
+                CPPA_CHECK_EQUAL(*blobs_received, num_fan_outs);
+                CPPA_CHECK_EQUAL(*fan_outs_received, num_fan_outs);
+                CPPA_CHECK(*urgent_received);
                 CPPA_CHECK_EQUAL(f, 4.2f);
                 await_foobars();
                 return atom("SyncReply");
@@ -328,6 +446,33 @@ int main(int argc, char** argv) {
     announce<actor_vector>();
     announce_tuple<atom_value, int>();
     announce_tuple<atom_value, atom_value, int>();
+    // trailing arguments optionally select the wire format: "compact"
+    // enables the compact format and compresses large messages such as
+    // {'Blob', ...} in server and client, "mixed" only in the server;
+    // "transport=tcp" keeps the client from switching to shared memory
+    string wire_format;
+    string transport;
+    const char wire_format_arg[] = "wire_format=";
+    const char transport_arg[] = "transport=";
+    auto wire_format_arg_size = sizeof(wire_format_arg) - 1;
+    auto transport_arg_size = sizeof(transport_arg) - 1;
+    for (bool done = false; argc > 1 && !done; ) {
+        auto last = argv[argc - 1];
+        if (strncmp(last, wire_format_arg, wire_format_arg_size) == 0) {
+            wire_format = last + wire_format_arg_size;
+            --argc;
+        }
+        else if (strncmp(last, transport_arg, transport_arg_size) == 0) {
+            transport = last + transport_arg_size;
+            --argc;
+        }
+        else done = true;
+    }
+    if (transport == "tcp") shm_transport(false);
+    if (wire_format == "compact" || wire_format == "mixed") {
+        compact_wire_format(true);
+        frame_compression_threshold(1024);
+    }
     string app_path = argv[0];
     bool run_remote_actor = true;
     bool run_as_server = false;
@@ -342,9 +487,17 @@ int main(int argc, char** argv) {
             run_as_server = true;
         }
         else {
-            run_client_part(get_kv_pairs(argc, argv), [](uint16_t port) {
+            auto args = get_kv_pairs(argc, argv);
+            run_client_part(args, [&](uint16_t port) {
+                auto dual_port = static_cast<uint16_t>(stoi(args["dual_port"]));
                 scoped_actor self;
                 auto serv = remote_actor("localhost", port);
+#               ifdef CPPA_LINUX
+                // the server runs on the same host, i.e., the client
+                // talks to it via shared memory unless told otherwise
+                CPPA_CHECK_EQUAL(num_shm_mappings(),
+                                 transport == "tcp" ? 0u : 1u);
+#               endif
                 // remote_actor is supposed to return the same server
                 // when connecting to the same host again
                 {
@@ -353,6 +506,24 @@ int main(int argc, char** argv) {
                     std::string localhost("127.0.0.1");
                     auto server3 = remote_actor(localhost, port);
                     CPPA_CHECK(serv == server3);
+#                   ifndef CPPA_WINDOWS
+                    auto server4 = remote_actor(unix_socket_path(port));
+                    CPPA_CHECK(serv == server4);
+#                   endif
+#                   ifdef CPPA_LINUX
+                    auto shm_path = shm_socket_path(port);
+                    auto shm = io::shm_io_stream::connect_to(shm_path);
+                    auto server6 = remote_actor(io::stream_ptr_pair(shm, shm));
+                    CPPA_CHECK(serv == server6);
+#                   endif
+                    check_remote_actor_async(self, serv, localhost, port);
+                    // IPv6 and IPv4 clients of an acceptor listening
+                    // on all interfaces
+                    CPPA_CHECK(remote_actor("::1", dual_port) == serv);
+                    CPPA_CHECK(remote_actor("localhost", dual_port) == serv);
+                    check_remote_actor_async(self, serv, "::1", dual_port);
+                    check_remote_actor_async(self, serv, "localhost", port);
+                    check_async_failover(port);
                 }
                 auto c = self->spawn<client, monitored>(serv);
                 self->receive (
@@ -368,27 +539,27 @@ int main(int argc, char** argv) {
     { // lifetime scope of self
         scoped_actor self;
         auto serv = self->spawn<server, monitored>();
-        uint16_t port = 4242;
-        bool success = false;
-        do {
-            try {
-                publish(serv, port, "127.0.0.1");
-                success = true;
-                CPPA_LOGF_DEBUG("running on port " << port);
-            }
-            catch (bind_failure&) {
-                // try next port
-                ++port;
-            }
-        }
-        while (!success);
+        auto port = publish_at_free_port(serv, "127.0.0.1");
+        auto dual_port = publish_at_free_port(serv, nullptr);
+#       ifndef CPPA_WINDOWS
+        publish(serv, unix_socket_path(port));
+#       endif
+#       ifdef CPPA_LINUX
+        publish(serv, io::shm_acceptor::create(shm_socket_path(port)));
+#       endif
+        // remote_actor returns the actor itself within the same process
+        CPPA_CHECK(remote_actor("localhost", port) == serv);
+        CPPA_CHECK(remote_actor("127.0.0.1", port) == serv);
         do {
             CPPA_TEST(test_remote_actor);
             thread child;
             ostringstream oss;
             if (run_remote_actor) {
                 oss << app_path << " run=remote_actor port=" << port
-                    << to_dev_null;
+                    << " dual_port=" << dual_port;
+                if (wire_format == "compact") oss << " wire_format=compact";
+                if (!transport.empty()) oss << " transport=" << transport;
+                oss << to_dev_null;
                 // execute client_part() in a separate process,
                 // connected via localhost socket
                 child = thread([&oss]() {
@@ -27,6 +27,7 @@
 #include "cppa/cow_tuple.hpp"
 #include "cppa/any_tuple.hpp"
 #include "cppa/announce.hpp"
+#include "cppa/match_expr.hpp"
 #include "cppa/tuple_cast.hpp"
 #include "cppa/any_tuple.hpp"
 #include "cppa/to_string.hpp"
@@ -36,6 +37,7 @@
 #include "cppa/deserializer.hpp"
 #include "cppa/primitive_type.hpp"
 #include "cppa/actor_namespace.hpp"
+#include "cppa/address_lookup_table.hpp"
 #include "cppa/primitive_variant.hpp"
 #include "cppa/binary_serializer.hpp"
 #include "cppa/binary_deserializer.hpp"
@@ -44,6 +46,7 @@
 #include "cppa/util/pt_token.hpp"
 #include "cppa/util/int_list.hpp"
 #include "cppa/util/algorithm.hpp"
+#include "cppa/util/byte_slice.hpp"
 #include "cppa/util/type_traits.hpp"
 #include "cppa/util/abstract_uniform_type_info.hpp"
 
@@ -83,6 +86,20 @@ struct raw_struct {
     string str;
 };
 
+// written as single block
+struct pod_struct {
+    int32_t a;
+    int16_t b;
+    uint16_t c;
+};
+
+// written as one block after packing d
+struct mixed_struct {
+    int32_t a;
+    uint8_t e;
+    double d;
+};
+
 bool operator==(const raw_struct& lhs, const raw_struct& rhs) {
     return lhs.str == rhs.str;
 }
@@ -230,6 +247,65 @@ int main() {
     }
     catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
 
+    try {
+        // actor addresses are written in full only once per lookup table
+        scoped_actor self;
+        auto ttup = make_any_tuple(1, actor{self.get()}, actor{});
+        address_lookup_table outgoing;
+        address_lookup_table incoming;
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing, nullptr, &outgoing);
+        bs << ttup;
+        auto first_size = wr_buf.size();
+        bs << ttup;
+        CPPA_CHECK(wr_buf.size() - first_size < first_size);
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(),
+                               &addressing, nullptr, &incoming);
+        any_tuple ttup2;
+        any_tuple ttup3;
+        uniform_typeid<any_tuple>()->deserialize(&ttup2, &bd);
+        uniform_typeid<any_tuple>()->deserialize(&ttup3, &bd);
+        CPPA_CHECK(ttup == ttup2);
+        CPPA_CHECK(ttup == ttup3);
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
+    try {
+        // a full table starts again at alias 1 on both sides
+        address_lookup_table outgoing;
+        address_lookup_table incoming;
+        node_id::host_id_type hid;
+        hid.fill(0xAB);
+        node_id_ptr node = new node_id(1, hid);
+        bool is_new = false;
+        auto max = address_lookup_table::max_aliases;
+        for (actor_id aid = 1; aid <= max; ++aid) {
+            CPPA_CHECK_EQUAL(outgoing.actor_alias(*node, aid, is_new), aid);
+            incoming.emplace_actor(aid, node, aid);
+        }
+        CPPA_CHECK_EQUAL(outgoing.actor_alias(*node, max, is_new), max);
+        CPPA_CHECK(!is_new);
+        auto generation = outgoing.generation();
+        CPPA_CHECK_EQUAL(outgoing.actor_alias(*node, max + 1, is_new), 1);
+        CPPA_CHECK(is_new);
+        CPPA_CHECK(outgoing.generation() != generation);
+        CPPA_CHECK_EQUAL(outgoing.actor_alias(*node, 1, is_new), 2);
+        CPPA_CHECK(is_new);
+        incoming.emplace_actor(1, node, max + 1);
+        CPPA_CHECK_EQUAL(incoming.actor_by_alias(1).second, max + 1);
+        CPPA_CHECK(incoming.actor_by_alias(2).first == nullptr);
+        // undoing aliases across a reset discards all aliases,
+        // because the receiver never saw the reset
+        auto cp = outgoing.make_checkpoint();
+        for (actor_id aid = 2; aid <= max + 1; ++aid) {
+            outgoing.actor_alias(*node, aid, is_new);
+        }
+        outgoing.truncate(cp);
+        CPPA_CHECK_EQUAL(outgoing.actor_alias(*node, max + 1, is_new), 1);
+        CPPA_CHECK(is_new);
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
     try {
         // serialize b1 to buf
         util::buffer wr_buf;
@@ -267,6 +343,208 @@ int main() {
     }
     catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
 
+    // test bulk serialization of arithmetic sequences and unicode strings
+    try {
+        announce<vector<float>>();
+        announce<vector<double>>();
+        announce<vector<int16_t>>();
+        CPPA_CHECK_EQUAL(detail::impl_id<vector<float>>(), 4);
+        CPPA_CHECK_EQUAL(detail::impl_id<vector<bool>>(), 1);
+        vector<float> floats{1.5f, -2.25f, 0.0f, 1e10f};
+        vector<double> doubles(100000);
+        for (size_t i = 0; i < doubles.size(); ++i) {
+            doubles[i] = static_cast<double>(i) / 3.0 - 1000.0;
+        }
+        vector<int16_t> ints{-1, 0, 1, 32767, -32768};
+        u16string str16{u"bulk \u00e4\u00f6\u00fc"};
+        u32string str32{U"bulk \U0001F600"};
+        auto tup = make_any_tuple(floats, doubles, ints, str16, str32);
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << tup;
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+        any_tuple tup2;
+        uniform_typeid<any_tuple>()->deserialize(&tup2, &bd);
+        auto opt = tuple_cast<vector<float>, vector<double>, vector<int16_t>,
+                              u16string, u32string>(tup2);
+        CPPA_CHECK(opt.valid());
+        if (opt.valid()) {
+            auto& t = *opt;
+            CPPA_CHECK(get<0>(t) == floats);
+            CPPA_CHECK(get<1>(t) == doubles);
+            CPPA_CHECK(get<2>(t) == ints);
+            CPPA_CHECK(get<3>(t) == str16);
+            CPPA_CHECK(get<4>(t) == str32);
+        }
+        // the string serializer writes each element separately
+        auto ints_str = to_string(make_any_tuple(ints));
+        CPPA_CHECK(ints_str.find("( { -1, 0, 1, 32767, -32768 } )")
+                   != string::npos);
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
+    // test byte slices
+    try {
+        util::byte_slice slice{string("hello world")};
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << make_any_tuple(slice);
+        // without storage, slices are copied out of the source buffer
+        any_tuple msg1;
+        binary_deserializer bd1(wr_buf.data(), wr_buf.size(), &addressing);
+        uniform_typeid<any_tuple>()->deserialize(&msg1, &bd1);
+        auto opt1 = tuple_cast<util::byte_slice>(msg1);
+        CPPA_CHECK(opt1.valid());
+        if (opt1.valid()) {
+            auto& res = get<0>(*opt1);
+            CPPA_CHECK(res == slice);
+            CPPA_CHECK_EQUAL(res.storage()->get().size(), slice.size());
+        }
+        // otherwise, slices refer to the storage
+        util::shared_buffer_ptr storage{new util::shared_buffer(move(wr_buf))};
+        auto& sbuf = storage->get();
+        auto first = reinterpret_cast<const char*>(sbuf.data());
+        any_tuple msg2;
+        binary_deserializer bd2(sbuf.data(), sbuf.size(), &addressing);
+        bd2.storage(storage);
+        uniform_typeid<any_tuple>()->deserialize(&msg2, &bd2);
+        auto opt2 = tuple_cast<util::byte_slice>(msg2);
+        CPPA_CHECK(opt2.valid());
+        if (opt2.valid()) {
+            auto& res = get<0>(*opt2);
+            CPPA_CHECK(res == slice);
+            CPPA_CHECK(res.storage() == storage);
+            CPPA_CHECK(res.begin() > first && res.end() <= first + sbuf.size());
+        }
+        // slices must not exceed the source buffer
+        util::buffer bad_buf;
+        binary_serializer bad_bs(&bad_buf, &addressing);
+        bad_bs.write_value(static_cast<uint32_t>(100));
+        binary_deserializer bad(bad_buf.data(), bad_buf.size(), &addressing);
+        bad.storage(storage);
+        util::byte_slice bad_slice;
+        try {
+            uniform_typeid<util::byte_slice>()->deserialize(&bad_slice, &bad);
+            CPPA_FAILURE("slice exceeding its source accepted");
+        }
+        catch (exception&) { CPPA_CHECKPOINT(); }
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
+    // test flat storage for tuples matching a statically typed pattern
+    try {
+        auto msg = make_any_tuple(uint16_t{1}, 2.5, string("three"));
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        bs << msg;
+        auto deserialize = [&]() -> any_tuple {
+            any_tuple result;
+            binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+            uniform_typeid<any_tuple>()->deserialize(&result, &bd);
+            return result;
+        };
+        CPPA_CHECK(deserialize().dynamically_typed());
+        bool invoked = false;
+        auto expr = (
+            on<uint16_t, double, string>() >> [&](uint16_t, double,
+                                                  const string& str) {
+                invoked = str == "three";
+            }
+        );
+        auto tup = deserialize();
+        CPPA_CHECK(!tup.dynamically_typed());
+        CPPA_CHECK(tup.type_token() == msg.type_token());
+        CPPA_CHECK(tup == msg);
+        expr(tup);
+        CPPA_CHECK(invoked);
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
+    // test native layout of announced types
+    try {
+        announce<pod_struct>(&pod_struct::a, &pod_struct::b, &pod_struct::c);
+        announce<mixed_struct>(&mixed_struct::a, &mixed_struct::e,
+                               &mixed_struct::d);
+        pod_struct pod{-42, 7, 65535};
+        mixed_struct mixed{100, 3, -0.125};
+        util::buffer wr_buf;
+        binary_serializer bs(&wr_buf, &addressing);
+        uniform_typeid<pod_struct>()->serialize(&pod, &bs);
+        uniform_typeid<mixed_struct>()->serialize(&mixed, &bs);
+        // must produce the same output as serializing each member
+        util::buffer expected;
+        binary_serializer ebs(&expected, &addressing);
+        ebs.write_value(pod.a);
+        ebs.write_value(pod.b);
+        ebs.write_value(pod.c);
+        ebs.write_value(mixed.a);
+        ebs.write_value(mixed.e);
+        ebs.write_value(mixed.d);
+        CPPA_CHECK_EQUAL(wr_buf.size(), expected.size());
+        CPPA_CHECK(memcmp(wr_buf.data(), expected.data(), wr_buf.size()) == 0);
+        binary_deserializer bd(wr_buf.data(), wr_buf.size(), &addressing);
+        pod_struct pod2{0, 0, 0};
+        mixed_struct mixed2{0, 0, 0};
+        uniform_typeid<pod_struct>()->deserialize(&pod2, &bd);
+        uniform_typeid<mixed_struct>()->deserialize(&mixed2, &bd);
+        CPPA_CHECK(pod2.a == pod.a && pod2.b == pod.b && pod2.c == pod.c);
+        CPPA_CHECK(mixed2.a == mixed.a && mixed2.e == mixed.e
+                   && mixed2.d == mixed.d);
+        // the string serializer still writes each member
+        auto pod_str = to_string(object::from(pod));
+        CPPA_CHECK(pod_str.find("-42") != string::npos);
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
+    // test compact format
+    try {
+        scoped_actor self;
+        auto tup = make_any_tuple(int64_t{-1}, uint32_t{300}, int16_t{-200},
+                                  vector<int16_t>{-1, 0, 1, 32767, -32768},
+                                  string("compact"), actor{self.get()});
+        util::buffer fixed_buf;
+        util::buffer compact_buf;
+        binary_serializer fixed_bs(&fixed_buf, &addressing);
+        binary_serializer compact_bs(&compact_buf, &addressing);
+        compact_bs.compact(true);
+        fixed_bs << tup;
+        compact_bs << tup;
+        CPPA_CHECK(compact_buf.size() < fixed_buf.size());
+        binary_deserializer bd(compact_buf.data(), compact_buf.size(),
+                               &addressing);
+        bd.compact(true);
+        any_tuple tup2;
+        uniform_typeid<any_tuple>()->deserialize(&tup2, &bd);
+        CPPA_CHECK(tup == tup2);
+        // malformed varints are rejected
+        uint8_t overlong[11];
+        std::fill(overlong, overlong + 11, 0xFF);
+        binary_deserializer bad(overlong, sizeof(overlong));
+        bad.compact(true);
+        try {
+            bad.read<uint64_t>();
+            CPPA_FAILURE("malformed varint accepted");
+        }
+        catch (exception&) { CPPA_CHECKPOINT(); }
+        // the 10th byte of a varint holds only the most significant bit
+        uint8_t too_large[10];
+        std::fill(too_large, too_large + 9, 0xFF);
+        too_large[9] = 0x02;
+        binary_deserializer bad2(too_large, sizeof(too_large));
+        bad2.compact(true);
+        try {
+            bad2.read<uint64_t>();
+            CPPA_FAILURE("varint exceeding 64 bits accepted");
+        }
+        catch (exception&) { CPPA_CHECKPOINT(); }
+        too_large[9] = 0x01;
+        binary_deserializer max_bd(too_large, sizeof(too_large));
+        max_bd.compact(true);
+        CPPA_CHECK_EQUAL(max_bd.read<uint64_t>(),
+                         numeric_limits<uint64_t>::max());
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
     // test serialization of enums
     try {
         auto enum_tuple = make_any_tuple(test_enum::b);
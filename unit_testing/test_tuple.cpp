@@ -453,6 +453,25 @@ void check_drop() {
     CPPA_CHECK(t0.take(0).empty());
 }
 
+void check_type_names() {
+    CPPA_PRINT(__func__);
+    auto t0 = make_any_tuple(0, 1, 2, 3);
+    auto t1 = make_any_tuple(2, 3);
+    auto t2 = make_any_tuple(2, "3");
+    CPPA_CHECK_EQUAL(*t1.tuple_type_names(), "@<>+@i32+@i32");
+    // names are interned, i.e., equal for all implementations
+    CPPA_CHECK(t0.drop(2).tuple_type_names() == t1.tuple_type_names());
+    CPPA_CHECK(t0.drop(1).tuple_type_names() != t1.tuple_type_names());
+    CPPA_CHECK_EQUAL(*t0.drop(1).tuple_type_names(), "@<>+@i32+@i32+@i32");
+    auto oarr = new detail::object_array;
+    oarr->push_back(object::from(2));
+    CPPA_CHECK_EQUAL(*oarr->tuple_type_names(), "@<>+@i32");
+    oarr->push_back(object::from(3));
+    any_tuple t3{static_cast<any_tuple::raw_ptr>(oarr)};
+    CPPA_CHECK(t3.tuple_type_names() == t1.tuple_type_names());
+    CPPA_CHECK(t3.tuple_type_names() != t2.tuple_type_names());
+}
+
 } // namespace <anonymous>
 
 int main() {
@@ -465,6 +484,7 @@ int main() {
     check_wildcards();
     check_move_ops();
     check_drop();
+    check_type_names();
     await_all_actors_done();
     shutdown();
     return CPPA_TEST_RESULT();
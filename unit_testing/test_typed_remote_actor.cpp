@@ -80,6 +80,24 @@ std::uint16_t run_server() {
     }
 }
 
+// remote_actor_async only returns untyped handles, i.e., it must
+// refuse the typed server even though it runs in this process
+void check_local_async_connect(std::uint16_t port) {
+    scoped_actor self;
+    remote_actor_async(self, "127.0.0.1", port);
+    self->receive (
+        on(atom("CONNECTED"), arg_match)
+        >> [&](const string&, std::uint16_t, const actor&) {
+            CPPA_FAILURE("remote_actor_async returned a typed actor");
+        },
+        on(atom("CONN_FAIL"), arg_match)
+        >> [&](const string&, std::uint16_t, const string& err) {
+            cout << err << endl;
+            CPPA_CHECKPOINT();
+        }
+    );
+}
+
 int main(int argc, char** argv) {
     announce<ping>(&ping::value);
     announce<pong>(&pong::value);
@@ -105,6 +123,7 @@ int main(int argc, char** argv) {
     CPPA_CHECKPOINT();
     auto port = run_server();
     CPPA_CHECKPOINT();
+    check_local_async_connect(port);
     if (run_remote_actor) {
         CPPA_CHECKPOINT();
         thread child;
@@ -11,6 +11,7 @@
 #include <iostream>
 #include <iterator>
 #include <algorithm>
+#include <thread>
 #include <stdexcept>
 
 #include "test.hpp"
@@ -95,6 +96,7 @@ int main() {
         "@proc",                     // intrusive_ptr<node_id>
         "@duration",                 // util::duration
         "@buffer",                   // util::buffer
+        "@slice",                    // util::byte_slice
         "@down",                     // down_msg
         "@exit",                     // exit_msg
         "@timeout",                  // timeout_msg
@@ -104,6 +106,7 @@ int main() {
         "@conn_closed",              // connection_closed_msg
         "@new_conn",                 // new_connection_msg
         "@new_data",                 // new_data_msg
+        "@peer_congested",           // peer_congested_msg
         // default announced cppa tuples
         "@<>+@atom",                 // {atom_value}
         "@<>+@atom+@actor",          // {atom_value, actor_ptr}
@@ -219,5 +222,32 @@ int main() {
     CPPA_CHECK(arr3[1] == uniform_type_info::from("@u16"));
     CPPA_CHECK(uniform_type_info::from("@u16") == uniform_typeid<std::uint16_t>());
 
+    // lookups run without locking while other threads add types
+    auto u16_by_name = uniform_type_info::from("@u16");
+    auto foo_by_rtti = uniform_typeid(typeid(foo));
+    std::atomic<bool> done{false};
+    std::atomic<size_t> mismatches{0};
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            while (!done) {
+                if (   uniform_type_info::from("@u16") != u16_by_name
+                    || uniform_typeid(typeid(foo)) != foo_by_rtti) {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    std::string tname = "@<>";
+    for (int i = 0; i < 100; ++i) {
+        tname += "+@u16";
+        auto uti = uniform_type_info::from(tname);
+        CPPA_CHECK(uti != nullptr && uti->name() == tname);
+        CPPA_CHECK(uniform_type_info::from(tname) == uti);
+    }
+    done = true;
+    for (auto& t : readers) t.join();
+    CPPA_CHECK_EQUAL(mismatches.load(), 0);
+
     return CPPA_TEST_RESULT();
 }